@@ -0,0 +1,101 @@
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "broadcast_ring_buffer.hpp"
+
+// 测量put的开销与读者进程个数的关系, 以及各个读者收到/错过的消息数
+//
+// 用法: broadcast_publish [消息个数]
+
+const char* kRingBufferName = "/broadcast_publish";
+const size_t kCapacity = 1024;
+
+struct Message {
+    uint64_t index;
+    uint8_t payload[56];
+};
+
+using Channel = NamedBroadcastRingBuffer<Message, kCapacity>;
+
+void run(int reader_count, uint64_t count) {
+    SharedMemoryObject::remove(kRingBufferName);
+    Channel channel(kRingBufferName);
+
+    int fds[2];
+    if (pipe(fds) != 0) {
+        perror("pipe");
+        exit(1);
+    }
+    std::vector<pid_t> children;
+    for (int i = 0; i < reader_count; i++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            Channel reader(kRingBufferName);
+            char ready = 1;
+            if (write(fds[1], &ready, 1) != 1) {
+                _exit(1);
+            }
+            Message message;
+            do {
+                reader.get(message);
+            } while (message.index != count - 1);
+            uint64_t result[2] = {reader.sequence() + 1 - reader.lost(), reader.lost()};
+            if (write(fds[1], result, sizeof(result)) != sizeof(result)) {
+                _exit(1);
+            }
+            _exit(0);
+        }
+        children.push_back(pid);
+    }
+    for (int i = 0; i < reader_count; i++) {
+        char ready;
+        if (read(fds[0], &ready, 1) != 1) {
+            perror("read");
+            exit(1);
+        }
+    }
+
+    Message message = {};
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < count; i++) {
+        message.index = i;
+        channel.put(message);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    uint64_t received = 0;
+    uint64_t lost = 0;
+    for (int i = 0; i < reader_count; i++) {
+        uint64_t result[2];
+        if (read(fds[0], result, sizeof(result)) != sizeof(result)) {
+            perror("read");
+            exit(1);
+        }
+        received += result[0];
+        lost += result[1];
+    }
+    for (pid_t pid: children) {
+        waitpid(pid, nullptr, 0);
+    }
+    close(fds[0]);
+    close(fds[1]);
+    SharedMemoryObject::remove(kRingBufferName);
+
+    printf("readers %2d: put %6.1f ns/msg, per reader received %10.0f lost %10.0f\n",
+            reader_count, elapsed.count() / count,
+            reader_count ? (double) received / reader_count : 0.0,
+            reader_count ? (double) lost / reader_count : 0.0);
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1000000;
+    for (int readers: {0, 1, 2, 4, 8}) {
+        run(readers, count);
+    }
+}
@@ -0,0 +1,67 @@
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "broadcast_ring_buffer.hpp"
+
+using namespace std::literals;
+
+const size_t kPayloadSize = 16;
+const char* kRingBufferName = "/sample_broadcast_ring_buffer";
+const uint32_t kFrameCount = 40;
+
+struct Frame {
+    uint32_t index;
+    uint8_t  data[kPayloadSize];
+};
+
+// 每个读者都收到全部的帧; 处理得慢的读者会错过一些帧, 但不会拖慢写者和其他读者
+void reader(int id, std::chrono::milliseconds delay) {
+    NamedBroadcastRingBuffer<Frame, 8> frames{kRingBufferName};
+    Frame frame;
+    do {
+        frames.get(frame);
+        std::this_thread::sleep_for(delay);
+    } while (frame.index != kFrameCount - 1);
+    std::cout << "reader " << id << ": received " << frames.sequence() + 1 - frames.lost()
+        << " frames, lost " << frames.lost() << std::endl;
+}
+
+void writer() {
+    NamedBroadcastRingBuffer<Frame, 8> frames{kRingBufferName};
+    Frame frame;
+    for (uint32_t i = 0; i < kFrameCount; i++) {
+        frame.index = i;
+        std::fill_n(frame.data, sizeof(frame.data) - 1, 'a' + i % 26);
+        frame.data[sizeof(frame.data) - 1] = '\0';
+        frames.put(frame);
+        std::this_thread::sleep_for(10ms);
+    }
+}
+
+int main() {
+    SharedMemoryObject::remove(kRingBufferName);
+    // 先创建共享内存, 保证读者在写者发布第一帧之前已经加入
+    NamedBroadcastRingBuffer<Frame, 8> frames{kRingBufferName};
+
+    std::vector<std::chrono::milliseconds> delays = {0ms, 5ms, 50ms};
+    std::vector<pid_t> children;
+    for (size_t i = 0; i < delays.size(); i++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            reader(i, delays[i]);
+            return 0;
+        }
+        children.push_back(pid);
+    }
+
+    std::this_thread::sleep_for(100ms);
+    writer();
+    for (pid_t pid: children) {
+        waitpid(pid, nullptr, 0);
+    }
+    SharedMemoryObject::remove(kRingBufferName);
+}
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include "shared_memory.hpp"
+#include "interprocess_once.hpp"
+#include "interprocess_doorbell.hpp"
+
+#define FMT_HEADER_ONLY
+#include "fmt/format.h"
+
+#define NAMED_BROADCAST_RING_BUFFER_MAGIC 0x62726362
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "atomic<uint64_t> need lock free");
+
+// 共享内存中的广播环形缓冲区, 一个写者, 任意多个读者.
+// - 写者按顺序给消息编号, 写入第n条消息时覆盖第n-N条, 从不等待读者
+// - 每个槽带一个序号(写入中为奇数, 写完为偶数), 读者复制数据前后各检查一次序号,
+//   发现槽已经被覆盖就跳过这条消息并计入lost(), 慢读者不会阻塞写者
+// - 读位置保存在各自进程的对象中, 共享内存里没有读者列表, put的开销与读者个数无关;
+//   只有存在休眠的读者时put才通过futex进入内核
+// - 每个对象都可以put和get, 但同一时刻只能有一个进程put
+template <typename T, size_t N>
+class NamedBroadcastRingBuffer {
+public:
+    static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable to live in shared memory");
+    static_assert(N > 0, "N must be positive");
+
+    // from_oldest为true时从缓冲区中最旧的消息开始读, 否则只读之后写入的消息
+    explicit NamedBroadcastRingBuffer(const char* name, bool from_oldest = false): impl_(name) {
+        Impl* impl = &impl_.get();
+        interprocess_call_once(impl->once_flag, [impl]() {
+                new (&impl->write_seq) std::atomic<uint64_t>(0);
+                new (&impl->readable) InterprocessDoorbell();
+                for (size_t i = 0; i < N; i++) {
+                    new (&impl->slots[i].seq) std::atomic<uint64_t>(0);
+                }
+                impl->magic = NAMED_BROADCAST_RING_BUFFER_MAGIC;
+                impl->type_size = sizeof(T);
+                impl->buffer_size = N;
+                });
+        check_ring_buffer_valid(impl->magic, impl->type_size, impl->buffer_size);
+
+        next_ = impl->write_seq.load(std::memory_order_acquire);
+        if (from_oldest) {
+            next_ = next_ > N ? next_ - N : 0;
+        }
+    }
+
+    // 发布一条消息, 总是O(1), 不等待读者
+    void put(const T& value) {
+        Impl& impl = impl_.get();
+        uint64_t n = impl.write_seq.load(std::memory_order_relaxed);
+        Slot& slot = impl.slots[n % N];
+        slot.seq.store(2 * n + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(static_cast<void*>(&slot.value), &value, sizeof(T));
+        slot.seq.store(2 * n + 2, std::memory_order_release);
+        impl.write_seq.store(n + 1, std::memory_order_release);
+        impl.readable.ring_all();
+    }
+
+    // 没有新消息时返回false; 被覆盖的消息跳过并计入lost()
+    bool try_get(T& value) {
+        Impl& impl = impl_.get();
+        while (true) {
+            uint64_t published = impl.write_seq.load(std::memory_order_acquire);
+            if (next_ == published) {
+                return false;
+            }
+            if (published - next_ > N) {
+                lost_ += published - N - next_;
+                next_ = published - N;
+            }
+
+            Slot& slot = impl.slots[next_ % N];
+            uint64_t expect = 2 * next_ + 2;
+            if (slot.seq.load(std::memory_order_acquire) != expect) {
+                lost_++;
+                next_++;
+                continue;
+            }
+            // 先复制到局部变量, 确认没有被覆盖之后再交给调用者, 返回false时value保持不变
+            T copy;
+            std::memcpy(static_cast<void*>(&copy), &slot.value, sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.seq.load(std::memory_order_relaxed) != expect) {
+                // 复制期间写者开始覆盖这个槽
+                lost_++;
+                next_++;
+                continue;
+            }
+            value = copy;
+            sequence_ = next_++;
+            return true;
+        }
+    }
+
+    // 等待新消息, 先自旋, 再在futex门铃上休眠
+    void get(T& value) {
+        for (int i = 0; i < kSpinCount; i++) {
+            if (try_get(value)) {
+                return;
+            }
+            std::this_thread::yield();
+        }
+
+        InterprocessDoorbell& readable = impl_.get().readable;
+        while (true) {
+            uint32_t seq = readable.prepare_wait();
+            bool got = try_get(value);
+            if (!got) {
+                readable.wait(seq);
+            }
+            readable.finish_wait();
+            if (got) {
+                return;
+            }
+        }
+    }
+
+    // 最近一次get/try_get读到的消息序号, 第一条消息的序号为0
+    uint64_t sequence() const {
+        return sequence_;
+    }
+
+    // 这个读者因为读得太慢而错过的消息总数
+    uint64_t lost() const {
+        return lost_;
+    }
+
+    // 写者已经发布的消息总数
+    uint64_t published() const {
+        return impl_.get().write_seq.load(std::memory_order_acquire);
+    }
+
+private:
+    void check_ring_buffer_valid(uint32_t magic, size_t type_size, size_t buffer_size) {
+        if (magic != NAMED_BROADCAST_RING_BUFFER_MAGIC) {
+            throw std::runtime_error(
+                    fmt::format("check_ring_buffer_valid failed, invalid magic: expect [{}], in fact [{}] ",
+                        NAMED_BROADCAST_RING_BUFFER_MAGIC, magic)
+                    );
+        }
+
+        if (type_size != sizeof(T)) {
+            throw std::runtime_error(
+                    fmt::format("check_ring_buffer_valid failed, invalid type size: expect [{}], in fact [{}] ", sizeof(T), type_size)
+                    );
+        }
+
+        if (buffer_size != N) {
+            throw std::runtime_error(
+                    fmt::format("check_ring_buffer_valid failed, invalid buffer size: expect [{}], in fact [{}] ", N, buffer_size)
+                    );
+        }
+    }
+
+private:
+    static constexpr size_t kCacheLineSize = 64;
+    static constexpr int kSpinCount = 64;
+
+    struct alignas(kCacheLineSize) Slot {
+        std::atomic<uint64_t> seq;
+        T value;
+    };
+
+    struct Impl {
+        InterprocessOnceFlag once_flag;
+        uint32_t magic;
+        size_t type_size;
+        size_t buffer_size;
+        alignas(kCacheLineSize) std::atomic<uint64_t> write_seq;    // 已发布的消息数
+        alignas(kCacheLineSize) InterprocessDoorbell readable;
+        Slot slots[N];
+    };
+
+    SharedMemory<Impl> impl_;
+
+    // 读者的本地状态
+    uint64_t next_ = 0;         // 下一条要读的消息序号
+    uint64_t sequence_ = 0;
+    uint64_t lost_ = 0;
+};
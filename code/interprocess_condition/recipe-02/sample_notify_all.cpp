@@ -0,0 +1,38 @@
+// condition_variable example
+#include <iostream>           // std::cout
+#include <thread>             // std::thread
+#include <mutex>              // std::unique_lock
+#include "interprocess_mutex.hpp"
+#include "interprocess_condition.hpp" 
+
+InterprocessMutex mtx;
+InterprocessCondition cv;
+bool ready = false;
+
+void print_id (int id) {
+    std::unique_lock<InterprocessMutex> lck(mtx);
+    while (!ready) cv.wait(lck);
+    // ...
+    std::cout << "thread " << id << '\n';
+}
+
+void go() {
+    std::unique_lock<InterprocessMutex> lck(mtx);
+    ready = true;
+    cv.notify_all();
+}
+
+int main ()
+{
+    std::thread threads[10];
+    // spawn 10 threads:
+    for (int i=0; i<10; ++i)
+        threads[i] = std::thread(print_id,i);
+
+    std::cout << "10 threads ready to race...\n";
+    go();                       // go!
+
+    for (auto& th : threads) th.join();
+
+    return 0;
+}
@@ -0,0 +1,37 @@
+#include "interprocess_condition.hpp"
+#include <climits>
+#include "futex.hpp"
+
+InterprocessCondition::InterprocessCondition() noexcept: seq_(0), waiters_(0) {
+}
+
+InterprocessCondition::~InterprocessCondition() {
+}
+
+void InterprocessCondition::notify_one() {
+    wake(1);
+}
+
+void InterprocessCondition::notify_all() {
+    wake(INT_MAX);
+}
+
+// 在持有锁时登记为等待者并读取序号, 之后的notify要么看到等待者, 要么在修改条件之前就已经完成
+uint32_t InterprocessCondition::prepare_wait() {
+    waiters_.fetch_add(1, std::memory_order_seq_cst);
+    return seq_.load(std::memory_order_seq_cst);
+}
+
+// 释放锁之后序号已经被notify改变时立即返回
+void InterprocessCondition::wait_impl(uint32_t seq) {
+    futex_wait(&seq_, seq);
+    waiters_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void InterprocessCondition::wake(int count) {
+    if (waiters_.load(std::memory_order_seq_cst) == 0) {
+        return;
+    }
+    seq_.fetch_add(1, std::memory_order_seq_cst);
+    futex_wake(&seq_, count);
+}
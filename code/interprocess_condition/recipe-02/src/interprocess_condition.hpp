@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <assert.h>
+
+// 基于futex的进程间条件变量, 可以放在共享内存中, 不需要销毁.
+// - 只有存在等待者时notify才进入内核
+// - wait可以配合任何提供unlock/lock的锁使用, 例如std::unique_lock<InterprocessMutex>
+// - 与std::condition_variable一样可能虚假唤醒, 需要在循环中检查条件
+class InterprocessCondition {
+public:
+    InterprocessCondition() noexcept;
+    ~InterprocessCondition();
+
+    void notify_one();
+    void notify_all();
+
+    template <typename L>
+    void wait(L& lock) {
+        assert(lock);
+        uint32_t seq = prepare_wait();
+        lock.unlock();
+        wait_impl(seq);
+        lock.lock();
+    }
+
+    template <typename L, typename Pr>
+    void wait(L& lock, Pr pred) {
+        while (!pred()) {
+            wait(lock);
+        }
+    }
+
+private:
+    InterprocessCondition(const InterprocessCondition&) = delete;
+    InterprocessCondition& operator= (const InterprocessCondition&) = delete;
+
+    uint32_t prepare_wait();
+    void wait_impl(uint32_t seq);
+    void wake(int count);
+
+private:
+    std::atomic<uint32_t> seq_;
+    std::atomic<uint32_t> waiters_;
+};
@@ -0,0 +1,28 @@
+// mutex::native_handle
+#include <iostream>       // std::cout
+#include <thread>         // std::thread
+#include <type_traits>
+#include "interprocess_mutex.hpp"
+
+InterprocessMutex mtx;           // mutex for critical section
+
+void print_thread_id (int id) {
+    // critical section (exclusive access to std::cout signaled by locking mtx):
+    mtx.lock();
+    // futex字: 0未加锁, 1加锁, 2加锁并且可能有等待者
+    std::cout << "thread #" << id << ", futex word " << mtx.native_handle()->load() << '\n';
+    mtx.unlock();
+}
+
+int main ()
+{
+    static_assert(std::is_same<InterprocessMutex::native_handle_type, std::atomic<uint32_t>*>::value);
+    std::thread threads[10];
+    // spawn 10 threads:
+    for (int i=0; i<10; ++i)
+        threads[i] = std::thread(print_thread_id,i+1);
+
+    for (auto& th : threads) th.join();
+
+    return 0;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be 32 bits");
+
+// 进程间共享的futex操作, 不使用FUTEX_PRIVATE_FLAG, futex字可以放在共享内存中
+
+// *addr不等于expected时立即返回; timeout为相对时间, nullptr表示一直等待
+inline int futex_wait(std::atomic<uint32_t>* addr, uint32_t expected, const struct timespec* timeout = nullptr) {
+    return syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr), FUTEX_WAIT, expected, timeout, nullptr, 0);
+}
+
+inline int futex_wake(std::atomic<uint32_t>* addr, int count) {
+    return syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr), FUTEX_WAKE, count, nullptr, nullptr, 0);
+}
+
+// 自旋等待时降低功耗, 让出流水线给同一物理核的另一个超线程
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
@@ -0,0 +1,52 @@
+#include "interprocess_mutex.hpp"
+#include <algorithm>
+#include "futex.hpp"
+
+namespace {
+
+const int32_t kMaxSpinCount = 100;
+
+const bool kSpinEnabled = sysconf(_SC_NPROCESSORS_ONLN) > 1;
+
+}   // namespace
+
+InterprocessMutex::InterprocessMutex() noexcept: state_(kUnlocked), spin_(0) {
+}
+
+InterprocessMutex::~InterprocessMutex() {
+}
+
+void InterprocessMutex::unlock_slow() {
+    futex_wake(&state_, 1);
+}
+
+// 与glibc的PTHREAD_MUTEX_ADAPTIVE_NP相同: 最多自旋平均值的2倍加10次, 然后按自旋的结果更新平均值
+void InterprocessMutex::lock_slow() {
+    if (kSpinEnabled) {
+        int32_t spin = spin_.load(std::memory_order_relaxed);
+        int32_t max_count = std::min(kMaxSpinCount, spin * 2 + 10);
+        int32_t count = 0;
+        bool locked = false;
+        while (count < max_count) {
+            count++;
+            uint32_t state = state_.load(std::memory_order_relaxed);
+            if (state == kUnlocked && state_.compare_exchange_weak(state, kLocked,
+                        std::memory_order_acquire, std::memory_order_relaxed)) {
+                locked = true;
+                break;
+            }
+            cpu_relax();
+        }
+        spin_.store(spin + (count - spin) / 8, std::memory_order_relaxed);
+        if (locked) {
+            return;
+        }
+    }
+
+    // 标记为有等待者后休眠, 醒来后同样以kContended加锁, 保证解锁时会唤醒其余的等待者
+    uint32_t state = state_.exchange(kContended, std::memory_order_acquire);
+    while (state != kUnlocked) {
+        futex_wait(&state_, kContended);
+        state = state_.exchange(kContended, std::memory_order_acquire);
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// 基于futex的进程间互斥量, 可以放在共享内存中, 不需要销毁.
+// - 没有竞争时加锁/解锁都只有一次原子操作, 不进入内核
+// - 有竞争时先自适应自旋(单核机器上不自旋), 仍然拿不到锁才在futex上休眠
+// - 不检查持有者, 持有锁的进程崩溃后其他进程会一直等待
+class InterprocessMutex {
+public:
+    InterprocessMutex() noexcept;
+    ~InterprocessMutex();
+
+    // 加锁/解锁的快速路径放在头文件中内联, 竞争时才调用lock_slow/unlock_slow
+    void lock() {
+        uint32_t state = kUnlocked;
+        if (!state_.compare_exchange_strong(state, kLocked, std::memory_order_acquire, std::memory_order_relaxed)) {
+            lock_slow();
+        }
+    }
+
+    bool try_lock() {
+        uint32_t state = kUnlocked;
+        return state_.compare_exchange_strong(state, kLocked, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock() {
+        if (state_.exchange(kUnlocked, std::memory_order_release) == kContended) {
+            unlock_slow();
+        }
+    }
+
+    using native_handle_type = std::atomic<uint32_t>*;
+
+    // futex字: 0未加锁, 1加锁, 2加锁并且可能有等待者
+    native_handle_type native_handle() {
+        return &state_;
+    }
+
+private:
+    InterprocessMutex(const InterprocessMutex&) = delete;
+    InterprocessMutex& operator= (const InterprocessMutex&) = delete;
+
+    enum State: uint32_t {
+        kUnlocked = 0,
+        kLocked = 1,
+        kContended = 2,
+    };
+
+    void lock_slow();
+    void unlock_slow();
+
+private:
+    std::atomic<uint32_t> state_;
+    std::atomic<int32_t> spin_;     // 最近几次自旋拿到锁所用次数的平均值
+};
@@ -0,0 +1,98 @@
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "interprocess_once.hpp"
+
+// 模拟N个进程同时打开同一个命名对象: 所有进程在同一时刻调用interprocess_call_once,
+// 其中一个执行耗时init_us的初始化, 输出所有进程返回的平均/最大时间和子进程消耗的CPU时间.
+// 同一份源码分别编译:
+// - interprocess_once_attach: 等待者在futex上休眠(recipe-03)
+// - interprocess_once_attach_poll: 等待者自旋加sleep_for轮询(recipe-02)
+//
+// 用法: interprocess_once_attach [最多进程数] [初始化耗时us]
+
+#ifdef POLL_ONCE
+const char* kImpl = "poll";
+#else
+const char* kImpl = "futex";
+#endif
+
+struct Shared {
+    InterprocessOnceFlag once_flag;
+    int initialized;
+};
+
+int64_t monotonic_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+double cpu_ms(const struct rusage& usage) {
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1e3 + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e3;
+}
+
+void run(int nprocs, int init_us) {
+    // 匿名共享内存初始为全0, 和ftruncate出来的共享内存一样
+    Shared* shared = static_cast<Shared*>(mmap(nullptr, sizeof(Shared), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0));
+    int64_t* elapsed = static_cast<int64_t*>(mmap(nullptr, sizeof(int64_t) * nprocs, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0));
+    if (shared == MAP_FAILED || elapsed == MAP_FAILED) {
+        perror("mmap");
+        exit(1);
+    }
+
+    struct rusage before;
+    getrusage(RUSAGE_CHILDREN, &before);
+
+    // 所有子进程都创建好之后同时开始
+    int64_t start_ns = monotonic_ns() + 20000000LL + nprocs * 1000000LL;
+    struct timespec start = {static_cast<time_t>(start_ns / 1000000000), static_cast<long>(start_ns % 1000000000)};
+    std::vector<pid_t> children;
+    for (int i = 0; i < nprocs; i++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &start, nullptr);
+            interprocess_call_once(shared->once_flag, [shared, init_us]() {
+                    std::this_thread::sleep_for(std::chrono::microseconds(init_us));
+                    shared->initialized++;
+                    });
+            elapsed[i] = monotonic_ns() - start_ns;
+            _exit(0);
+        }
+        children.push_back(pid);
+    }
+    for (pid_t pid: children) {
+        waitpid(pid, nullptr, 0);
+    }
+
+    struct rusage after;
+    getrusage(RUSAGE_CHILDREN, &after);
+
+    int64_t total = 0;
+    int64_t max = 0;
+    for (int i = 0; i < nprocs; i++) {
+        total += elapsed[i];
+        max = elapsed[i] > max ? elapsed[i] : max;
+    }
+    printf("%-6s procs %3d: avg %8.1f us, max %8.1f us, cpu %8.2f ms, initialized %d\n",
+            kImpl, nprocs, total / 1e3 / nprocs, max / 1e3, cpu_ms(after) - cpu_ms(before), shared->initialized);
+
+    munmap(shared, sizeof(Shared));
+    munmap(elapsed, sizeof(int64_t) * nprocs);
+}
+
+int main(int argc, char* argv[]) {
+    int max_procs = argc > 1 ? atoi(argv[1]) : 64;
+    int init_us = argc > 2 ? atoi(argv[2]) : 5000;
+    for (int nprocs = 1; nprocs <= max_procs; nprocs *= 2) {
+        run(nprocs, init_us);
+    }
+}
@@ -0,0 +1,61 @@
+#include "interprocess_once.hpp"
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <climits>
+
+namespace {
+
+enum ExecuteState: uint32_t {
+    Not_yet_executed = 0,
+    Executing = 1,
+    Executing_with_waiters = 2,     // 有等待者在futex上休眠, 执行结束后需要唤醒
+    Executed = 3,
+};
+
+// 不使用FUTEX_PRIVATE_FLAG, flag可以放在共享内存中
+void futex_wait(std::atomic<uint32_t>* addr, uint32_t expected) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr), FUTEX_WAIT, expected, nullptr, nullptr, 0);
+}
+
+void futex_wake_all(std::atomic<uint32_t>* addr) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+void finish(std::atomic<uint32_t>& state, uint32_t new_state) {
+    if (state.exchange(new_state, std::memory_order_acq_rel) == Executing_with_waiters) {
+        futex_wake_all(&state);
+    }
+}
+
+}   // namespace
+
+void interprocess_call_once(InterprocessOnceFlag& flag, std::function<void()> fn) {
+    std::atomic<uint32_t>& state = flag.state;
+    uint32_t current = state.load(std::memory_order_acquire);
+    while (current != Executed) {
+        if (current == Not_yet_executed) {
+            if (!state.compare_exchange_strong(current, Executing, std::memory_order_acquire)) {
+                continue;
+            }
+
+            try {
+                fn();
+            } catch (...) {
+                finish(state, Not_yet_executed);
+                throw;  // rethrow
+            }
+            finish(state, Executed);
+            return;
+        }
+
+        // 正在执行, 标记有等待者后休眠, 直到状态改变
+        if (current == Executing &&
+                !state.compare_exchange_strong(current, Executing_with_waiters, std::memory_order_acquire)) {
+            continue;
+        }
+        futex_wait(&state, Executing_with_waiters);
+        current = state.load(std::memory_order_acquire);
+    }
+}
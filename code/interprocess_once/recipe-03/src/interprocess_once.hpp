@@ -0,0 +1,15 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be 32 bits");
+
+// 全0为初始状态, 放在ftruncate出来的共享内存中不需要构造
+struct InterprocessOnceFlag {
+    std::atomic<uint32_t> state{0};     // futex字
+};
+
+// fn抛出异常时状态恢复为未执行, 等待者中的一个重新执行
+void interprocess_call_once(InterprocessOnceFlag& flag, std::function<void()> fn);
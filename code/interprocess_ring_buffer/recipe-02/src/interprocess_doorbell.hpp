@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be 32 bits");
+
+// 放在共享内存中的门铃, 等待方在futex上休眠, 通知方只有存在等待者时才进入内核.
+// 等待流程:
+//   uint32_t seq = doorbell.prepare_wait();
+//   if (!条件满足) doorbell.wait(seq);
+//   doorbell.finish_wait();
+// 通知方在条件满足之后调用ring()
+class InterprocessDoorbell {
+public:
+    InterprocessDoorbell(): seq_(0), waiters_(0) {}
+
+    uint32_t prepare_wait() {
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        uint32_t seq = seq_.load(std::memory_order_seq_cst);
+        // 与ring中的栅栏配对: 要么ring看到等待者, 要么随后的条件检查看到通知方的修改
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return seq;
+    }
+
+    // seq在prepare_wait之后被ring改变时立即返回
+    void wait(uint32_t seq) {
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&seq_), FUTEX_WAIT, seq, nullptr, nullptr, 0);
+    }
+
+    void finish_wait() {
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void ring(int count = 1) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+        seq_.fetch_add(1, std::memory_order_seq_cst);
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&seq_), FUTEX_WAKE, count, nullptr, nullptr, 0);
+    }
+
+    void ring_all() {
+        ring(INT_MAX);
+    }
+
+private:
+    InterprocessDoorbell(const InterprocessDoorbell&) = delete;
+    InterprocessDoorbell& operator= (const InterprocessDoorbell&) = delete;
+
+private:
+    std::atomic<uint32_t> seq_;
+    std::atomic<uint32_t> waiters_;
+};
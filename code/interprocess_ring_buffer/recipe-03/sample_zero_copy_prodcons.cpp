@@ -0,0 +1,45 @@
+#include <thread>
+#include <chrono>
+#include <iostream>
+#include "interprocess_ring_buffer.hpp"
+
+using namespace std::literals;
+
+const size_t kPayloadSize = 16;
+
+struct Frame {
+    uint32_t index;
+    uint8_t  data[kPayloadSize];
+};
+
+InterprocessRingBuffer<Frame, 5> frames;
+
+// 生产者直接在缓冲区的槽中填充帧, 消费者直接读取槽中的帧, 两边都不复制Frame
+void producer() {
+    for (size_t i = 0; i < 20; i++) {
+        Frame* frame = frames.reserve_write();
+        frame->index = i;
+        std::fill_n(frame->data, sizeof(frame->data) - 1, 'a' + i);
+        frame->data[sizeof(frame->data) - 1] = '\0';
+        frames.commit_write(frame);
+        std::this_thread::sleep_for(100ms);
+    }
+}
+
+void consumer() {
+    for (size_t i = 0; i < 20; i++) {
+        const Frame* frame = frames.peek_read();
+        std::cout << "Frame " << frame->index << ": " << frame->data << std::endl;
+        frames.release_read(frame);
+    }
+}
+
+int main() {
+    std::thread thr_produce, thr_consume;
+
+    thr_produce = std::thread(consumer);
+    thr_consume = std::thread(producer);
+
+    thr_produce.join();
+    thr_consume.join();
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "ring_buffer.hpp"
+#include "interprocess_mutex.hpp"
+#include "interprocess_condition.hpp"
+#include <mutex>
+
+// 零拷贝接口reserve_write/commit_write和peek_read/release_read在锁外读写共享内存中的槽:
+// - 同一时刻最多一个未提交的写槽, 其他生产者(包括put)等待commit_write
+// - 同一时刻最多一个未释放的读槽, 其他消费者(包括get)等待release_read
+// - 缓冲区满时写入需要丢弃最旧的数据, 如果它正在被读取, 生产者等待release_read
+template <typename T, size_t N>
+class InterprocessRingBuffer {
+private:
+    InterprocessMutex mtx_;
+    InterprocessCondition cv_;        // 通知消费者: 有数据可读
+    InterprocessCondition write_cv_;  // 通知生产者: 可以写入
+    RingBuffer<T, N> buffer_;
+    bool writing_ = false;
+    bool reading_ = false;
+
+    bool writable() {
+        return !writing_ && !(reading_ && buffer_.full());
+    }
+
+    bool readable() {
+        return !reading_ && buffer_.has_data();
+    }
+
+public:
+    InterprocessRingBuffer() {}
+
+    void put(const T& value) {
+        std::unique_lock<InterprocessMutex> lck(mtx_);
+        write_cv_.wait(lck, [this] { return writable(); });
+        buffer_.put(value);
+        cv_.notify_one();
+    }
+
+    void get(T& value) {
+        std::unique_lock<InterprocessMutex> lck(mtx_);
+        cv_.wait(lck, [this] { return readable(); });
+        buffer_.get(value);
+    }
+
+    bool try_get(T& value) {
+        std::lock_guard<InterprocessMutex> lck(mtx_);
+        if (readable()) {
+            buffer_.get(value);
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    T* reserve_write() {
+        std::unique_lock<InterprocessMutex> lck(mtx_);
+        write_cv_.wait(lck, [this] { return writable(); });
+        writing_ = true;
+        return buffer_.reserve_write();
+    }
+
+    void commit_write(T* slot) {
+        std::lock_guard<InterprocessMutex> lck(mtx_);
+        buffer_.commit_write(slot);
+        writing_ = false;
+        cv_.notify_one();
+        write_cv_.notify_one();
+    }
+
+    // 等待数据可读, 返回最旧数据所在的槽
+    const T* peek_read() {
+        std::unique_lock<InterprocessMutex> lck(mtx_);
+        cv_.wait(lck, [this] { return readable(); });
+        reading_ = true;
+        return buffer_.peek_read();
+    }
+
+    // 缓冲区空或者已有未释放的读槽时返回nullptr
+    const T* try_peek_read() {
+        std::lock_guard<InterprocessMutex> lck(mtx_);
+        if (!readable()) {
+            return nullptr;
+        }
+        reading_ = true;
+        return buffer_.peek_read();
+    }
+
+    void release_read(const T* slot) {
+        std::lock_guard<InterprocessMutex> lck(mtx_);
+        buffer_.release_read(slot);
+        reading_ = false;
+        if (buffer_.has_data()) {
+            cv_.notify_one();
+        }
+        write_cv_.notify_one();
+    }
+};
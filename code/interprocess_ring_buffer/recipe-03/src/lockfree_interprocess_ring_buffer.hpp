@@ -0,0 +1,204 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include "interprocess_doorbell.hpp"
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "atomic<uint64_t> need lock free");
+
+// 可以放在共享内存中的无锁环形缓冲区, 支持多个生产者和多个消费者进程.
+// 每个槽带一个序号, put/get通过CAS抢占写/读位置, 快速路径上只有原子操作;
+// 缓冲区空时get先自旋, 再在futex门铃上休眠, put只有在存在休眠的消费者时才进入内核.
+// put在缓冲区满时丢弃最旧的数据, 与InterprocessRingBuffer的行为一致.
+// 零拷贝接口reserve_write/commit_write和peek_read/release_read直接读写槽中的数据,
+// 多个生产者/消费者可以同时持有各自的槽, 槽在提交/释放之前不会被其他进程读写.
+template <typename T, size_t N>
+class LockfreeInterprocessRingBuffer {
+private:
+    static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable to live in shared memory");
+
+    static constexpr size_t kCacheLineSize = 64;
+    static constexpr int kSpinCount = 64;
+
+    struct alignas(kCacheLineSize) Slot {
+        std::atomic<uint64_t> sequence;
+        T value;
+    };
+
+    alignas(kCacheLineSize) std::atomic<uint64_t> write_pos_;
+    alignas(kCacheLineSize) std::atomic<uint64_t> read_pos_;
+    alignas(kCacheLineSize) InterprocessDoorbell not_empty_;
+    Slot slots_[N];
+
+    Slot* claim_write_slot(uint64_t& pos) {
+        pos = write_pos_.load(std::memory_order_relaxed);
+        while (true) {
+            Slot* slot = &slots_[pos % N];
+            uint64_t seq = slot->sequence.load(std::memory_order_acquire);
+            int64_t diff = (int64_t) seq - (int64_t) pos;
+            if (diff == 0) {
+                if (write_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    return slot;
+                }
+            } else if (diff < 0) {
+                return nullptr;
+            } else {
+                pos = write_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    Slot* claim_read_slot(uint64_t& pos) {
+        pos = read_pos_.load(std::memory_order_relaxed);
+        while (true) {
+            Slot* slot = &slots_[pos % N];
+            uint64_t seq = slot->sequence.load(std::memory_order_acquire);
+            int64_t diff = (int64_t) seq - (int64_t) (pos + 1);
+            if (diff == 0) {
+                if (read_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    return slot;
+                }
+            } else if (diff < 0) {
+                return nullptr;
+            } else {
+                pos = read_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // 缓冲区满(写位置为write_pos)时丢弃最旧的一条数据, 不复制;
+    // 最旧的槽还没有提交, 或者已经被读者占用(get/peek_read还没有释放)时返回false, 调用者等待
+    bool drop_oldest(uint64_t write_pos) {
+        uint64_t pos = write_pos - N;
+        Slot* slot = &slots_[pos % N];
+        if (slot->sequence.load(std::memory_order_acquire) != pos + 1) {
+            return false;
+        }
+        if (!read_pos_.compare_exchange_strong(pos, pos + 1, std::memory_order_relaxed)) {
+            return false;
+        }
+        slot->sequence.store(pos + N, std::memory_order_release);
+        return true;
+    }
+
+    // 槽的序号在占用之后只由持有者修改, 提交/释放时不需要知道占用时的位置
+    Slot* slot_of(const T* value) {
+        size_t offset = reinterpret_cast<const char*>(value) - reinterpret_cast<const char*>(&slots_[0].value);
+        return &slots_[offset / sizeof(Slot)];
+    }
+
+    // 已被占用但尚未提交的槽也算在内
+    bool has_pending() const {
+        uint64_t pos = read_pos_.load(std::memory_order_relaxed);
+        return write_pos_.load(std::memory_order_relaxed) != pos;
+    }
+
+    // 缓冲区空时先自旋, 再在门铃上休眠, 直到attempt成功.
+    // 休眠条件按读写位置判断: 乱序提交唤醒的消费者如果因为read_pos_处的槽还没提交而再次休眠,
+    // 会吞掉这次通知. 休眠过的消费者取到数据后还有剩余时再敲一次门铃, 交给下一个休眠的消费者
+    template <typename Attempt>
+    void wait_readable(Attempt attempt) {
+        bool parked = false;
+        while (true) {
+            for (int i = 0; i < kSpinCount; i++) {
+                if (attempt()) {
+                    if (parked && has_pending()) {
+                        not_empty_.ring();
+                    }
+                    return;
+                }
+                std::this_thread::yield();
+            }
+
+            uint32_t seq = not_empty_.prepare_wait();
+            if (!has_pending()) {
+                not_empty_.wait(seq);
+            }
+            not_empty_.finish_wait();
+            parked = true;
+        }
+    }
+
+public:
+    LockfreeInterprocessRingBuffer(): write_pos_(0), read_pos_(0) {
+        for (size_t i = 0; i < N; i++) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // 缓冲区满时返回false
+    bool try_put(const T& value) {
+        uint64_t pos;
+        Slot* slot = claim_write_slot(pos);
+        if (!slot) {
+            return false;
+        }
+        slot->value = value;
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        not_empty_.ring();
+        return true;
+    }
+
+    // 缓冲区满时丢弃最旧的数据; 最旧的槽正在被读取时等待它被释放
+    void put(const T& value) {
+        T* slot = reserve_write();
+        *slot = value;
+        commit_write(slot);
+    }
+
+    void get(T& value) {
+        wait_readable([this, &value] { return try_get(value); });
+    }
+
+    bool try_get(T& value) {
+        uint64_t pos;
+        Slot* slot = claim_read_slot(pos);
+        if (!slot) {
+            return false;
+        }
+        value = slot->value;
+        slot->sequence.store(pos + N, std::memory_order_release);
+        return true;
+    }
+
+    // 占用下一个写槽, 缓冲区满时与put一样丢弃最旧的数据;
+    // 最旧的槽正在被get/peek_read读取时不丢弃更新的数据, 等待它被释放
+    T* reserve_write() {
+        uint64_t pos;
+        Slot* slot;
+        while ((slot = claim_write_slot(pos)) == nullptr) {
+            if (!drop_oldest(pos)) {
+                std::this_thread::yield();
+            }
+        }
+        return &slot->value;
+    }
+
+    void commit_write(T* value) {
+        Slot* slot = slot_of(value);
+        slot->sequence.store(slot->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        not_empty_.ring();
+    }
+
+    // 等待数据可读, 返回占用的读槽
+    const T* peek_read() {
+        const T* value;
+        wait_readable([this, &value] { return (value = try_peek_read()) != nullptr; });
+        return value;
+    }
+
+    // 缓冲区空时返回nullptr
+    const T* try_peek_read() {
+        uint64_t pos;
+        Slot* slot = claim_read_slot(pos);
+        return slot ? &slot->value : nullptr;
+    }
+
+    void release_read(const T* value) {
+        Slot* slot = slot_of(value);
+        slot->sequence.store(slot->sequence.load(std::memory_order_relaxed) - 1 + N, std::memory_order_release);
+    }
+};
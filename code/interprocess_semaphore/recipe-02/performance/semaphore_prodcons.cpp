@@ -0,0 +1,196 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "semaphore.hpp"
+#include "interprocess_semaphore.hpp"
+
+// 把prodcons2/3/4示例改成计时的测试, 输出每秒生产消费的个数.
+// 同一份源码分别编译:
+// - semaphore_prodcons: 基于futex的Semaphore/InterprocessSemaphore, 另外测试post(n)/try_wait(n)批量操作
+// - semaphore_prodcons_cond: 基于互斥量+条件变量的Semaphore/InterprocessSemaphore
+//
+// 用法: semaphore_prodcons [生产消费个数] [生产者/消费者线程数]
+
+#ifdef FUTEX_SEMAPHORE
+const char* kImpl = "futex";
+#else
+const char* kImpl = "mutex+cond";
+#endif
+
+template <typename S, int NBUFF>
+struct Shared {
+    int buff[NBUFF];
+    int nput = 0;
+    int nputval = 0;
+    int nget = 0;
+    int ngetval = 0;
+    S mutex{1};
+    S nempty{NBUFF};
+    S nstored{0};
+    int errors = 0;
+};
+
+// prodcons2: 一个生产者, 一个消费者
+template <typename S>
+void prodcons2(int nitems, int) {
+    Shared<S, 10> shared;
+    std::thread producer([&]() {
+            for (int i = 0; i < nitems; i++) {
+                shared.nempty.wait();
+                shared.mutex.wait();
+                shared.buff[i % 10] = i;
+                shared.mutex.post();
+                shared.nstored.post();
+            }
+            });
+    for (int i = 0; i < nitems; i++) {
+        shared.nstored.wait();
+        shared.mutex.wait();
+        if (shared.buff[i % 10] != i) {
+            shared.errors++;
+        }
+        shared.mutex.post();
+        shared.nempty.post();
+    }
+    producer.join();
+    if (shared.errors) {
+        printf("prodcons2: %d errors\n", shared.errors);
+    }
+}
+
+template <typename S, int NBUFF>
+void produce(Shared<S, NBUFF>& shared, int nitems) {
+    for ( ; ; ) {
+        shared.nempty.wait();
+        shared.mutex.wait();
+        if (shared.nput >= nitems) {
+            shared.nstored.post();      // 让消费者退出
+            shared.nempty.post();
+            shared.mutex.post();
+            return;
+        }
+        shared.buff[shared.nput % NBUFF] = shared.nputval;
+        shared.nput++;
+        shared.nputval++;
+        shared.mutex.post();
+        shared.nstored.post();
+    }
+}
+
+template <typename S, int NBUFF>
+void consume(Shared<S, NBUFF>& shared, int nitems) {
+    for ( ; ; ) {
+        shared.nstored.wait();
+        shared.mutex.wait();
+        if (shared.nget >= nitems) {
+            shared.nstored.post();
+            shared.mutex.post();
+            return;
+        }
+        int i = shared.nget % NBUFF;
+        if (shared.buff[i] != shared.ngetval) {
+            shared.errors++;
+        }
+        shared.nget++;
+        shared.ngetval++;
+        shared.mutex.post();
+        shared.nempty.post();
+    }
+}
+
+// prodcons3: 多个生产者, 一个消费者
+template <typename S>
+void prodcons3(int nitems, int nthreads) {
+    Shared<S, 3> shared;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < nthreads; i++) {
+        threads.emplace_back([&]() { produce(shared, nitems); });
+    }
+    consume(shared, nitems);
+    for (auto& thread: threads) {
+        thread.join();
+    }
+    if (shared.errors) {
+        printf("prodcons3: %d errors\n", shared.errors);
+    }
+}
+
+// prodcons4: 多个生产者, 多个消费者
+template <typename S>
+void prodcons4(int nitems, int nthreads) {
+    Shared<S, 10> shared;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < nthreads; i++) {
+        threads.emplace_back([&]() { produce(shared, nitems); });
+        threads.emplace_back([&]() { consume(shared, nitems); });
+    }
+    for (auto& thread: threads) {
+        thread.join();
+    }
+    if (shared.errors) {
+        printf("prodcons4: %d errors\n", shared.errors);
+    }
+}
+
+#ifdef FUTEX_SEMAPHORE
+// 一个生产者, 一个消费者, 生产者每16个post(16)一次, 消费者用try_wait(n)一次取走所有已有的
+template <typename S>
+void prodcons_batch(int nitems, int) {
+    const int kBatch = 16;
+    Shared<S, 64> shared;
+    std::thread producer([&]() {
+            int n = 0;
+            for (int i = 0; i < nitems; i++) {
+                shared.nempty.wait();
+                shared.buff[i % 64] = i;
+                if (++n == kBatch || i == nitems - 1) {
+                    shared.nstored.post(n);
+                    n = 0;
+                }
+            }
+            });
+    for (int i = 0; i < nitems; ) {
+        shared.nstored.wait();
+        int n = 1;
+        int more = shared.nstored.get_value();
+        if (more > 0 && shared.nstored.try_wait(more)) {
+            n += more;
+        }
+        for (int k = 0; k < n; k++, i++) {
+            if (shared.buff[i % 64] != i) {
+                shared.errors++;
+            }
+        }
+        shared.nempty.post(n);
+    }
+    producer.join();
+    if (shared.errors) {
+        printf("prodcons_batch: %d errors\n", shared.errors);
+    }
+}
+#endif
+
+void run(const char* title, const char* sem, void (*test)(int, int), int nitems, int nthreads) {
+    auto start = std::chrono::steady_clock::now();
+    test(nitems, nthreads);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    printf("%-16s %-12s %-22s %8.2f M items/s\n", title, kImpl, sem, nitems / elapsed.count() / 1e6);
+}
+
+int main(int argc, char* argv[]) {
+    int nitems = argc > 1 ? atoi(argv[1]) : 1000000;
+    int nthreads = argc > 2 ? atoi(argv[2]) : 4;
+
+    run("prodcons2", "Semaphore", prodcons2<Semaphore>, nitems, nthreads);
+    run("prodcons2", "InterprocessSemaphore", prodcons2<InterprocessSemaphore>, nitems, nthreads);
+    run("prodcons3", "Semaphore", prodcons3<Semaphore>, nitems, nthreads);
+    run("prodcons3", "InterprocessSemaphore", prodcons3<InterprocessSemaphore>, nitems, nthreads);
+    run("prodcons4", "Semaphore", prodcons4<Semaphore>, nitems, nthreads);
+    run("prodcons4", "InterprocessSemaphore", prodcons4<InterprocessSemaphore>, nitems, nthreads);
+#ifdef FUTEX_SEMAPHORE
+    run("prodcons_batch", "Semaphore", prodcons_batch<Semaphore>, nitems, nthreads);
+    run("prodcons_batch", "InterprocessSemaphore", prodcons_batch<InterprocessSemaphore>, nitems, nthreads);
+#endif
+}
@@ -0,0 +1,78 @@
+#include <thread>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include "interprocess_semaphore.hpp"
+
+#define	NBUFF	 64
+#define	BATCH	 16
+
+// 生产者每写满BATCH个槽post(BATCH)一次, 消费者等到至少一个后用try_wait(n)一次取走所有已有的
+int		nitems;					/* read-only by producer and consumer */
+struct {	/* data shared by producer and consumer */
+    int	buff[NBUFF];
+    InterprocessSemaphore *nempty, *nstored;
+} shared;
+
+void produce();
+void consume();
+
+int main(int argc, char **argv)
+{
+    if (argc != 2) {
+        printf("usage: sembatch <#items>\n");
+        exit(1);
+    }
+    nitems = atoi(argv[1]);
+
+    shared.nempty = new InterprocessSemaphore{NBUFF};
+    shared.nstored = new InterprocessSemaphore{0};
+
+    std::thread thr_produce(produce);
+    std::thread thr_consume(consume);
+
+    thr_produce.join();
+    thr_consume.join();
+
+    delete shared.nempty;
+    delete shared.nstored;
+    exit(0);
+}
+
+void produce()
+{
+    int		i, n = 0;
+
+    for (i = 0; i < nitems; i++) {
+        shared.nempty->wait();	/* wait for at least 1 empty slot */
+        shared.buff[i % NBUFF] = i;
+        if (++n == BATCH || i == nitems - 1) {
+            shared.nstored->post(n);	/* n more stored items */
+            n = 0;
+        }
+    }
+}
+
+void consume()
+{
+    int		i = 0, n, batches = 0, timeouts = 0;
+
+    while (i < nitems) {
+        if (!shared.nstored->wait_for(std::chrono::seconds(1))) {
+            timeouts++;
+            continue;
+        }
+        n = 1;
+        int more = shared.nstored->get_value();
+        if (more > 0 && shared.nstored->try_wait(more))
+            n += more;
+
+        for (int k = 0; k < n; k++, i++) {
+            if (shared.buff[i % NBUFF] != i)
+                printf("buff[%d] = %d\n", i, shared.buff[i % NBUFF]);
+        }
+        shared.nempty->post(n);		/* n more empty slots */
+        batches++;
+    }
+    printf("consumed %d items in %d batches, %d timeouts\n", nitems, batches, timeouts);
+}
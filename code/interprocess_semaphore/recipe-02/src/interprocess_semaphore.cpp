@@ -0,0 +1,86 @@
+#include "interprocess_semaphore.hpp"
+#include <unistd.h>
+#include <climits>
+#include <ctime>
+#include "futex.hpp"
+
+namespace {
+
+const int kSpinCount = 100;
+
+const bool kSpinEnabled = sysconf(_SC_NPROCESSORS_ONLN) > 1;
+
+int64_t monotonic_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+}   // namespace
+
+InterprocessSemaphore::InterprocessSemaphore(unsigned int value): count_(value), wakeups_(0) {
+}
+
+InterprocessSemaphore::~InterprocessSemaphore() {
+}
+
+void InterprocessSemaphore::post_slow(uint32_t wakeups) {
+    wakeups_.fetch_add(wakeups, std::memory_order_release);
+    futex_wake(&wakeups_, wakeups > INT_MAX ? INT_MAX : wakeups);
+}
+
+bool InterprocessSemaphore::take_wakeup() {
+    uint32_t wakeups = wakeups_.load(std::memory_order_relaxed);
+    while (wakeups > 0) {
+        if (wakeups_.compare_exchange_weak(wakeups, wakeups - 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// deadline_ns为nullptr时一直等待
+bool InterprocessSemaphore::wait_slow(const int64_t* deadline_ns) {
+    if (kSpinEnabled) {
+        for (int i = 0; i < kSpinCount; i++) {
+            cpu_relax();
+            if (try_wait()) {
+                return true;
+            }
+        }
+    }
+
+    // 登记为等待者, 之后的post会为我们发放一个唤醒
+    if (count_.fetch_sub(1, std::memory_order_acquire) > 0) {
+        return true;
+    }
+
+    while (!take_wakeup()) {
+        if (deadline_ns == nullptr) {
+            futex_wait(&wakeups_, 0);
+            continue;
+        }
+
+        int64_t remain = *deadline_ns - monotonic_ns();
+        if (remain > 0) {
+            struct timespec timeout = {static_cast<time_t>(remain / 1000000000), static_cast<long>(remain % 1000000000)};
+            futex_wait(&wakeups_, 0, &timeout);
+            continue;
+        }
+
+        // 超时后撤销登记; count_已经不为负数时post已经为我们发放了唤醒, 必须取走
+        int32_t count = count_.load(std::memory_order_relaxed);
+        while (count < 0) {
+            if (count_.compare_exchange_weak(count, count + 1, std::memory_order_relaxed)) {
+                return false;
+            }
+        }
+        deadline_ns = nullptr;
+    }
+    return true;
+}
+
+int InterprocessSemaphore::get_value() {
+    int32_t count = count_.load(std::memory_order_relaxed);
+    return count > 0 ? count : 0;
+}
@@ -0,0 +1,45 @@
+#include <thread>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "limitedsize_queue.hpp"
+
+// 生产者每次放入一批数据, 消费者每次最多取出4个
+void put_id(limitedsize_queue<int>& queue) {
+    int i = 0;
+    while (true) {
+        std::vector<int> batch;
+        for (int j = 0; j < 3; j++) {
+            batch.push_back(++i);
+        }
+        std::cout << "添加数据 " << batch.front() << "-" << batch.back() << std::endl;
+        queue.push_range(batch.begin(), batch.end());
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+}
+
+void get_id(int thread_id, limitedsize_queue<int>& queue) {
+    while (true) {
+        std::vector<int> values;
+        queue.pop_bulk(std::back_inserter(values), 4);
+        std::cout << "线程: " << thread_id << " 取值";
+        for (int i : values) {
+            std::cout << " " << i;
+        }
+        std::cout << std::endl;
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    }
+}
+
+int main() {
+    limitedsize_queue<int> id_queue(10);
+    auto Th1 = std::thread(put_id, std::ref(id_queue));
+
+    auto Th2 = std::thread(get_id, 2, std::ref(id_queue));
+    auto Th3 = std::thread(get_id, 3, std::ref(id_queue));
+
+    Th2.join();
+    Th1.join();
+    Th3.join();
+}
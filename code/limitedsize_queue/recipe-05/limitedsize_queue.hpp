@@ -0,0 +1,309 @@
+#pragma once
+#include <mutex>
+#include <condition_variable>
+#include <limits>
+#include <algorithm>
+#include <iterator>
+#include <chrono>
+#include <cassert>
+#include "queue_storage.hpp"
+
+enum class queue_push_policy {
+    drop_queue_front_item,
+    wait_queue_not_full
+};
+
+// 条件变量只在队列由空变为非空(由满变为非满)时通知, 而且只在确实有线程等待时通知;
+// 被唤醒的线程取走(放入)元素后, 如果还有剩余元素(空位)和等待线程, 再接力唤醒下一个.
+// 批量接口push_range/pop_bulk/drain_into一次加锁搬运多个元素.
+// Storage为存储策略, 使用ring_storage时元素保存在预先分配的连续环形数组中, 稳定运行时不分配内存.
+template<typename T, typename Storage = deque_storage<T>>
+class limitedsize_queue {
+private:
+    mutable std::mutex mut;
+    Storage data_queue;
+    std::condition_variable not_empty_cond;
+    std::condition_variable not_full_cond;
+    size_t max_size;
+    size_t waiting_poppers = 0;
+    size_t waiting_pushers = 0;
+
+public:
+    limitedsize_queue(size_t max_size_=std::numeric_limits<size_t>::max()): data_queue(max_size_), max_size(max_size_)
+    {}
+
+    void push(const T& new_value, queue_push_policy policy)
+    {
+        if (policy == queue_push_policy::wait_queue_not_full) {
+            return push(new_value);
+        } else if (policy == queue_push_policy::drop_queue_front_item) {
+            std::lock_guard<std::mutex> lk(mut);
+            size_t old_size = data_queue.size();
+            if (is_full()) {
+                data_queue.pop();
+            }
+
+            data_queue.push(new_value);
+            notify_pushed(old_size);
+        } else {
+            assert(false && "unknown policy type");
+        }
+    }
+
+    void push(const T& new_value)
+    {
+        std::unique_lock<std::mutex> lk(mut);
+        wait_not_full(lk);
+
+        size_t old_size = data_queue.size();
+        data_queue.push(new_value);
+        notify_pushed(old_size);
+    }
+
+    template <class Rep, class Period>
+    bool push(const T& new_value, const std::chrono::duration<Rep, Period> &timeout)
+    {
+        std::unique_lock<std::mutex> lk(mut);
+        if (wait_not_full(lk, timeout)) {
+            size_t old_size = data_queue.size();
+            data_queue.push(new_value);
+            notify_pushed(old_size);
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    void push(T&& new_value)
+    {
+        std::unique_lock<std::mutex> lk(mut);
+        wait_not_full(lk);
+
+        size_t old_size = data_queue.size();
+        data_queue.push(std::move(new_value));
+        notify_pushed(old_size);
+    }
+
+    // 把[first, last)中的元素移入队列, 队列满时等待, 每次加锁放入尽可能多的元素;
+    // drop_queue_front_item策略下不等待, 放不下时丢弃队首元素
+    template <typename Iterator>
+    void push_range(Iterator first, Iterator last,
+            queue_push_policy policy = queue_push_policy::wait_queue_not_full)
+    {
+        std::unique_lock<std::mutex> lk(mut);
+        while (first != last) {
+            if (policy == queue_push_policy::wait_queue_not_full) {
+                wait_not_full(lk);
+            }
+
+            size_t old_size = data_queue.size();
+            while (first != last && (policy == queue_push_policy::drop_queue_front_item || !is_full())) {
+                if (is_full()) {
+                    data_queue.pop();
+                }
+                data_queue.push(std::move(*first));
+                ++first;
+            }
+            notify_pushed(old_size);
+        }
+    }
+
+    void pop(T& value)
+    {
+        std::unique_lock<std::mutex> lk(mut);
+        wait_not_empty(lk);
+
+        size_t old_size = data_queue.size();
+        value=std::move(data_queue.front());
+        data_queue.pop();
+        notify_popped(old_size);
+    }
+
+    template <class Rep, class Period>
+    bool pop(T& value, const std::chrono::duration<Rep, Period> &timeout)
+    {
+        std::unique_lock<std::mutex> lk(mut);
+        if (wait_not_empty(lk, timeout))
+        {
+            size_t old_size = data_queue.size();
+            value=std::move(data_queue.front());
+            data_queue.pop();
+            notify_popped(old_size);
+            return true;
+        }
+        return false;
+    }
+
+    // 等待队列非空, 然后一次取出最多max_n个元素写入out, 返回取出的个数
+    template <typename OutputIterator>
+    size_t pop_bulk(OutputIterator out, size_t max_n)
+    {
+        std::unique_lock<std::mutex> lk(mut);
+        wait_not_empty(lk);
+        return pop_locked(out, max_n);
+    }
+
+    template <typename OutputIterator, class Rep, class Period>
+    size_t pop_bulk(OutputIterator out, size_t max_n, const std::chrono::duration<Rep, Period> &timeout)
+    {
+        std::unique_lock<std::mutex> lk(mut);
+        if (!wait_not_empty(lk, timeout)) {
+            return 0;
+        }
+        return pop_locked(out, max_n);
+    }
+
+    template <typename OutputIterator>
+    size_t try_pop_bulk(OutputIterator out, size_t max_n)
+    {
+        std::lock_guard<std::mutex> lk(mut);
+        return pop_locked(out, max_n);
+    }
+
+    // 等待队列非空, 然后把队列中的全部元素追加到container末尾, 返回取出的个数
+    template <typename Container>
+    size_t drain_into(Container& container)
+    {
+        return pop_bulk(std::back_inserter(container), std::numeric_limits<size_t>::max());
+    }
+
+    bool try_push(const T& new_value)
+    {
+        std::lock_guard<std::mutex> lk(mut);
+        if (is_full()) {
+            return false;
+        }
+
+        size_t old_size = data_queue.size();
+        data_queue.push(new_value);
+        notify_pushed(old_size);
+        return true;
+    }
+
+    bool try_pop(T& value)
+    {
+        std::lock_guard<std::mutex> lk(mut);
+        if (is_empty()) {
+            return false;
+        }
+
+        size_t old_size = data_queue.size();
+        value=std::move(data_queue.front());
+        data_queue.pop();
+        notify_popped(old_size);
+        return true;
+    }
+
+    bool empty() const
+    {
+        std::lock_guard<std::mutex> lk(mut);
+        return is_empty();
+    }
+
+    bool full() const
+    {
+        std::lock_guard<std::mutex> lk(mut);
+        return is_full();
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lk(mut);
+        return data_queue.size();
+    }
+
+    size_t capacity() const
+    {
+        std::lock_guard<std::mutex> lk(mut);
+        return max_size;
+    }
+
+private:
+    bool is_empty() const
+    {
+        return data_queue.empty();
+    }
+
+    bool is_full() const
+    {
+        return data_queue.size() >= max_size;
+    }
+
+    void wait_not_empty(std::unique_lock<std::mutex>& lk)
+    {
+        waiting_poppers++;
+        not_empty_cond.wait(lk,[this]{return !is_empty();});
+        waiting_poppers--;
+    }
+
+    template <class Rep, class Period>
+    bool wait_not_empty(std::unique_lock<std::mutex>& lk, const std::chrono::duration<Rep, Period> &timeout)
+    {
+        waiting_poppers++;
+        bool ready = not_empty_cond.wait_for(lk, timeout, [this]{return !is_empty();});
+        waiting_poppers--;
+        return ready;
+    }
+
+    void wait_not_full(std::unique_lock<std::mutex>& lk)
+    {
+        waiting_pushers++;
+        not_full_cond.wait(lk,[this]{return !is_full();});
+        waiting_pushers--;
+    }
+
+    template <class Rep, class Period>
+    bool wait_not_full(std::unique_lock<std::mutex>& lk, const std::chrono::duration<Rep, Period> &timeout)
+    {
+        waiting_pushers++;
+        bool ready = not_full_cond.wait_for(lk, timeout, [this]{return !is_full();});
+        waiting_pushers--;
+        return ready;
+    }
+
+    template <typename OutputIterator>
+    size_t pop_locked(OutputIterator out, size_t max_n)
+    {
+        size_t old_size = data_queue.size();
+        size_t n = std::min(old_size, max_n);
+        for (size_t i = 0; i < n; i++) {
+            *out = std::move(data_queue.front());
+            ++out;
+            data_queue.pop();
+        }
+        if (n > 0) {
+            notify_popped(old_size);
+        }
+        return n;
+    }
+
+    // old_size为放入元素之前的队列长度, 调用时持有mut
+    void notify_pushed(size_t old_size)
+    {
+        if (old_size == 0 && waiting_poppers > 0) {
+            size_t n = std::min(data_queue.size(), waiting_poppers);
+            for (size_t i = 0; i < n; i++) {
+                not_empty_cond.notify_one();
+            }
+        }
+        if (!is_full() && waiting_pushers > 0) {
+            // 放入后还有空位, 接力唤醒下一个生产者
+            not_full_cond.notify_one();
+        }
+    }
+
+    // old_size为取出元素之前的队列长度, 调用时持有mut
+    void notify_popped(size_t old_size)
+    {
+        if (old_size >= max_size && waiting_pushers > 0) {
+            size_t n = std::min(max_size - data_queue.size(), waiting_pushers);
+            for (size_t i = 0; i < n; i++) {
+                not_full_cond.notify_one();
+            }
+        }
+        if (!is_empty() && waiting_poppers > 0) {
+            // 取走后还有元素, 接力唤醒下一个消费者
+            not_empty_cond.notify_one();
+        }
+    }
+};
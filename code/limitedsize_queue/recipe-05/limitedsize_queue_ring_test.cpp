@@ -0,0 +1,83 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+
+#include "limitedsize_queue.hpp"
+
+// 统计全部operator new的调用次数
+static std::atomic<long> alloc_count(0);
+
+void* operator new(std::size_t size) {
+    alloc_count++;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+struct Frame {
+    int id;
+    char payload[240];
+};
+
+// 一个生产者一个消费者循环传递count个元素, 返回期间发生的内存分配次数
+template <typename Queue>
+long transfer(Queue& queue, int count, queue_push_policy policy) {
+    long before = alloc_count;
+    std::thread consumer([&queue, count, policy] {
+        Frame frame;
+        if (policy == queue_push_policy::wait_queue_not_full) {
+            for (int i = 0; i < count; i++) {
+                queue.pop(frame);
+            }
+        } else {
+            while (queue.pop(frame, std::chrono::milliseconds(100))) {
+            }
+        }
+    });
+    long thread_allocs = alloc_count - before;
+    for (int i = 0; i < count; i++) {
+        queue.push(Frame{i, {}}, policy);
+    }
+    consumer.join();
+    return alloc_count - before - thread_allocs;
+}
+
+template <typename Queue>
+void run(const std::string& name) {
+    const int kCount = 200000;
+    Queue queue(64);
+    auto start = std::chrono::steady_clock::now();
+    long allocs = transfer(queue, kCount, queue_push_policy::wait_queue_not_full);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    long drop_allocs = transfer(queue, kCount, queue_push_policy::drop_queue_front_item);
+    std::cout << name << ": " << kCount << " frames in " << elapsed.count() << " ms, "
+        << allocs << " allocations (wait), " << drop_allocs << " allocations (drop)" << std::endl;
+}
+
+int main() {
+    run<limitedsize_queue<Frame>>("deque_storage");
+    run<limitedsize_queue<Frame, ring_storage<Frame>>>("ring_storage");
+
+    // 不限长度时环形数组按2倍扩容
+    limitedsize_queue<std::string, ring_storage<std::string>> unbounded;
+    for (int i = 0; i < 100; i++) {
+        unbounded.push(std::to_string(i));
+    }
+    std::string value;
+    unbounded.pop(value);
+    std::cout << "unbounded ring: size " << unbounded.size() << ", front was " << value << std::endl;
+    return 0;
+}
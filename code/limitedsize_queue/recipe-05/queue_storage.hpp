@@ -0,0 +1,140 @@
+#pragma once
+#include <queue>
+#include <memory>
+#include <limits>
+#include <algorithm>
+#include <utility>
+#include <cassert>
+
+// limitedsize_queue的存储策略, 构造参数是队列的最大长度,
+// 需要提供empty/size/front/push/pop接口
+
+// 基于std::deque的存储, 元素分散在deque的各个内存块中, push时可能分配内存
+template<typename T>
+class deque_storage: public std::queue<T> {
+public:
+    explicit deque_storage(size_t /* max_size */)
+    {}
+};
+
+// 连续的环形数组存储, 元素在槽中原地构造.
+// 有界队列构造时一次分配max_size个槽, 之后不再分配内存;
+// 不限长度(max_size为size_t最大值)时从initial_capacity开始按2倍扩容
+template<typename T, typename Allocator = std::allocator<T>>
+class ring_storage {
+private:
+    typedef std::allocator_traits<Allocator> alloc_traits;
+
+    static const size_t initial_capacity = 16;
+
+    Allocator alloc;
+    T* slots;
+    size_t slot_count;
+    size_t max_capacity;
+    size_t head = 0;     // 队首元素所在的槽
+    size_t count = 0;
+
+    size_t index(size_t i) const
+    {
+        size_t pos = head + i;
+        return pos >= slot_count ? pos - slot_count : pos;
+    }
+
+    void grow()
+    {
+        size_t new_count = slot_count < max_capacity / 2 ? slot_count * 2 : max_capacity;
+        T* new_slots = alloc_traits::allocate(alloc, new_count);
+        for (size_t i = 0; i < count; i++) {
+            T* p = slots + index(i);
+            alloc_traits::construct(alloc, new_slots + i, std::move_if_noexcept(*p));
+            alloc_traits::destroy(alloc, p);
+        }
+        alloc_traits::deallocate(alloc, slots, slot_count);
+        slots = new_slots;
+        slot_count = new_count;
+        head = 0;
+    }
+
+public:
+    explicit ring_storage(size_t max_size, const Allocator& alloc_ = Allocator()):
+        alloc(alloc_), max_capacity(std::max<size_t>(max_size, 1))
+    {
+        slot_count = max_capacity == std::numeric_limits<size_t>::max() ?
+            initial_capacity : max_capacity;
+        slots = alloc_traits::allocate(alloc, slot_count);
+    }
+
+    ~ring_storage()
+    {
+        while (!empty()) {
+            pop();
+        }
+        alloc_traits::deallocate(alloc, slots, slot_count);
+    }
+
+    ring_storage(const ring_storage&) = delete;
+    ring_storage& operator=(const ring_storage&) = delete;
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    size_t capacity() const
+    {
+        return slot_count;
+    }
+
+    T& front()
+    {
+        return slots[head];
+    }
+
+    const T& front() const
+    {
+        return slots[head];
+    }
+
+    T& back()
+    {
+        return slots[index(count - 1)];
+    }
+
+    const T& back() const
+    {
+        return slots[index(count - 1)];
+    }
+
+    template <typename... Args>
+    void emplace(Args&&... args)
+    {
+        if (count == slot_count && slot_count < max_capacity) {
+            grow();
+        }
+        assert(count < slot_count && "ring storage overflow");
+        alloc_traits::construct(alloc, slots + index(count), std::forward<Args>(args)...);
+        count++;
+    }
+
+    void push(const T& value)
+    {
+        emplace(value);
+    }
+
+    void push(T&& value)
+    {
+        emplace(std::move(value));
+    }
+
+    void pop()
+    {
+        alloc_traits::destroy(alloc, slots + head);
+        head = index(1);
+        count--;
+    }
+};
@@ -0,0 +1,105 @@
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+#include "message_ring_buffer.hpp"
+
+using namespace std::literals;
+
+const char* kRingBufferName = "/sample_message_ring_buffer";
+const size_t kCapacity = 16 << 20;
+const size_t kReaderCount = 2;
+const size_t kMessageCount = 2000;
+const size_t kMinMessageSize = 64;
+const size_t kMaxMessageSize = 4 << 20;
+
+// 消息开头是序号, 后面的字节都等于序号的低8位, 读者据此检查消息是否完整
+void fill_message(uint8_t* data, size_t length, uint64_t index) {
+    memcpy(data, &index, sizeof(index));
+    memset(data + sizeof(index), (int) (index & 0xff), length - sizeof(index));
+}
+
+bool check_message(const uint8_t* data, size_t length, uint64_t index) {
+    uint64_t stored;
+    memcpy(&stored, data, sizeof(stored));
+    if (stored != index) {
+        return false;
+    }
+    for (size_t i = sizeof(index); i < length; i++) {
+        if (data[i] != (uint8_t) (index & 0xff)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void writer() {
+    NamedMessageRingBuffer ring(kRingBufferName, kCapacity);
+    while (ring.reader_count() < kReaderCount) {
+        std::this_thread::sleep_for(1ms);
+    }
+
+    // 消息长度在64B~4MB之间按对数均匀分布
+    std::mt19937_64 engine(42);
+    std::uniform_real_distribution<double> exponent(std::log2(kMinMessageSize), std::log2(kMaxMessageSize));
+    size_t bytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < kMessageCount; i++) {
+        size_t length = (size_t) std::exp2(exponent(engine));
+        uint8_t* data = static_cast<uint8_t*>(ring.reserve_write(length));
+        fill_message(data, length, i);
+        ring.commit_write(length);
+        bytes += length;
+    }
+    // 长度为0的消息表示结束
+    ring.write(nullptr, 0);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "writer: " << kMessageCount << " messages, " << bytes / (1 << 20) << " MB, "
+        << bytes / (1 << 20) / elapsed.count() << " MB/s" << std::endl;
+}
+
+void reader(int id) {
+    NamedMessageRingBuffer ring(kRingBufferName, kCapacity);
+    MessageRingBufferReader messages(ring);
+    size_t count = 0;
+    size_t errors = 0;
+    while (true) {
+        size_t length;
+        const uint8_t* data = static_cast<const uint8_t*>(messages.peek_read(length));
+        if (length == 0) {
+            messages.release_read();
+            break;
+        }
+        if (!check_message(data, length, count)) {
+            errors++;
+        }
+        messages.release_read();
+        count++;
+    }
+    std::cout << "reader " << id << ": " << count << " messages, " << errors << " errors" << std::endl;
+}
+
+int main() {
+    NamedMessageRingBuffer::remove(kRingBufferName);
+
+    std::vector<pid_t> children;
+    for (size_t i = 0; i < kReaderCount; i++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            reader(i);
+            return 0;
+        }
+        children.push_back(pid);
+    }
+
+    writer();
+    for (pid_t pid: children) {
+        waitpid(pid, nullptr, 0);
+    }
+    NamedMessageRingBuffer::remove(kRingBufferName);
+}
@@ -0,0 +1,398 @@
+#include "message_ring_buffer.hpp"
+
+#include <atomic>
+#include <new>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include "interprocess_once.hpp"
+#include "interprocess_doorbell.hpp"
+
+#define FMT_HEADER_ONLY
+#include "fmt/format.h"
+
+#define NAMED_MESSAGE_RING_BUFFER_MAGIC 0x6d736762
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "atomic<uint64_t> need lock free");
+
+namespace {
+
+const size_t kCacheLineSize = 64;
+const size_t kAlignment = 8;
+const int kSpinCount = 64;
+
+enum RecordKind: uint32_t {
+    kData = 1,
+    kPadding = 2,
+};
+
+struct RecordHeader {
+    uint32_t length;
+    uint32_t kind;
+};
+
+static_assert(sizeof(RecordHeader) == kAlignment, "record header must keep records aligned");
+
+size_t record_size(size_t length) {
+    return (sizeof(RecordHeader) + length + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+size_t round_up_power_of_2(size_t n) {
+    size_t power = kCacheLineSize;
+    while (power < n) {
+        power <<= 1;
+    }
+    return power;
+}
+
+}   // namespace
+
+struct NamedMessageRingBuffer::Header {
+    InterprocessOnceFlag once_flag;
+    uint32_t magic;
+    uint64_t capacity;
+    uint64_t max_readers;
+    alignas(kCacheLineSize) std::atomic<uint64_t> write_pos;
+    alignas(kCacheLineSize) InterprocessDoorbell data_ready;    // 读者等待新消息
+    alignas(kCacheLineSize) InterprocessDoorbell space_ready;   // 写者等待读者释放空间
+};
+
+struct NamedMessageRingBuffer::ReaderCursor {
+    alignas(kCacheLineSize) std::atomic<uint64_t> read_pos;
+    std::atomic<uint32_t> active;
+
+    ReaderCursor(): read_pos(0), active(0) {}
+};
+
+NamedMessageRingBuffer::NamedMessageRingBuffer(const char* name, size_t capacity, size_t max_readers):
+    shm_obj_(SharedMemoryObject::open_or_create(name)),
+    capacity_(round_up_power_of_2(capacity)), max_readers_(max_readers) {
+    if (max_readers_ == 0) {
+        throw std::invalid_argument("NamedMessageRingBuffer needs at least one reader cursor");
+    }
+    if (capacity_ > ((size_t) 1 << 32)) {
+        throw std::invalid_argument(fmt::format("NamedMessageRingBuffer capacity too large: {}", capacity));
+    }
+
+    map_size_ = sizeof(Header) + max_readers_ * sizeof(ReaderCursor) + capacity_;
+    if (shm_obj_.size() < map_size_) {
+        shm_obj_.truncate(map_size_);
+    }
+    map_addr_ = shm_obj_.map(map_size_);
+    header_ = static_cast<Header*>(map_addr_);
+    data_ = static_cast<uint8_t*>(map_addr_) + sizeof(Header) + max_readers_ * sizeof(ReaderCursor);
+
+    try {
+        interprocess_call_once(header_->once_flag, [this]() {
+                header_->magic = NAMED_MESSAGE_RING_BUFFER_MAGIC;
+                header_->capacity = capacity_;
+                header_->max_readers = max_readers_;
+                new (&header_->write_pos) std::atomic<uint64_t>(0);
+                new (&header_->data_ready) InterprocessDoorbell();
+                new (&header_->space_ready) InterprocessDoorbell();
+                for (size_t i = 0; i < max_readers_; i++) {
+                    new (cursor(i)) ReaderCursor();
+                }
+                });
+        check_ring_buffer_valid(capacity_, max_readers_);
+    } catch (...) {
+        SharedMemoryObject::unmap(map_addr_, map_size_);
+        throw;
+    }
+
+    write_pos_ = header_->write_pos.load(std::memory_order_acquire);
+    min_read_pos_ = write_pos_;
+}
+
+NamedMessageRingBuffer::~NamedMessageRingBuffer() {
+    SharedMemoryObject::unmap(map_addr_, map_size_);
+}
+
+void NamedMessageRingBuffer::check_ring_buffer_valid(size_t capacity, size_t max_readers) {
+    if (header_->magic != NAMED_MESSAGE_RING_BUFFER_MAGIC) {
+        throw std::runtime_error(
+                fmt::format("check_ring_buffer_valid failed, invalid magic: expect [{}], in fact [{}] ",
+                    NAMED_MESSAGE_RING_BUFFER_MAGIC, header_->magic)
+                );
+    }
+
+    if (header_->capacity != capacity) {
+        throw std::runtime_error(
+                fmt::format("check_ring_buffer_valid failed, invalid capacity: expect [{}], in fact [{}] ",
+                    capacity, header_->capacity)
+                );
+    }
+
+    if (header_->max_readers != max_readers) {
+        throw std::runtime_error(
+                fmt::format("check_ring_buffer_valid failed, invalid max readers: expect [{}], in fact [{}] ",
+                    max_readers, header_->max_readers)
+                );
+    }
+}
+
+NamedMessageRingBuffer::ReaderCursor* NamedMessageRingBuffer::cursor(size_t i) const {
+    return reinterpret_cast<ReaderCursor*>(static_cast<uint8_t*>(map_addr_) + sizeof(Header)) + i;
+}
+
+// refresh为false时使用上一次扫描的结果, 只有空间不够时才重新扫描所有读者
+size_t NamedMessageRingBuffer::free_space(bool refresh) {
+    if (refresh) {
+        // 与读者加入时的栅栏配对: 要么这里看到新读者, 要么新读者看到最新的写位置
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        uint64_t min_pos = write_pos_;
+        for (size_t i = 0; i < max_readers_; i++) {
+            ReaderCursor* c = cursor(i);
+            if (c->active.load(std::memory_order_relaxed)) {
+                uint64_t pos = c->read_pos.load(std::memory_order_acquire);
+                if (pos < min_pos) {
+                    min_pos = pos;
+                }
+            }
+        }
+        min_read_pos_ = min_pos;
+    }
+    // 新读者刚占用读位置时可能还残留着上一个读者很旧的位置, 此时认为没有空间
+    uint64_t used = write_pos_ - min_read_pos_;
+    return used >= capacity_ ? 0 : capacity_ - used;
+}
+
+bool NamedMessageRingBuffer::wait_space(size_t length, bool block) {
+    if (free_space(false) >= length || free_space(true) >= length) {
+        return true;
+    }
+    if (!block) {
+        return false;
+    }
+
+    for (int i = 0; i < kSpinCount; i++) {
+        std::this_thread::yield();
+        if (free_space(true) >= length) {
+            return true;
+        }
+    }
+
+    InterprocessDoorbell& space_ready = header_->space_ready;
+    while (true) {
+        uint32_t seq = space_ready.prepare_wait();
+        bool enough = free_space(true) >= length;
+        if (!enough) {
+            space_ready.wait(seq);
+        }
+        space_ready.finish_wait();
+        if (enough) {
+            return true;
+        }
+    }
+}
+
+void NamedMessageRingBuffer::publish(uint64_t write_pos) {
+    header_->write_pos.store(write_pos, std::memory_order_release);
+}
+
+void* NamedMessageRingBuffer::reserve(size_t length, bool block) {
+    if (reserved_) {
+        throw std::logic_error("reserve_write called again before commit_write");
+    }
+    if (length > max_message_size()) {
+        throw std::length_error(
+                fmt::format("message length {} exceeds max message size {}", length, max_message_size()));
+    }
+
+    size_t size = record_size(length);
+    size_t offset = write_pos_ & (capacity_ - 1);
+    size_t tail = capacity_ - offset;
+    if (tail < size) {
+        // 末尾放不下整条记录, 用填充记录占满末尾, 读者读到时直接跳过
+        if (!wait_space(tail, block)) {
+            return nullptr;
+        }
+        RecordHeader* padding = reinterpret_cast<RecordHeader*>(data_ + offset);
+        padding->length = tail - sizeof(RecordHeader);
+        padding->kind = kPadding;
+        write_pos_ += tail;
+        publish(write_pos_);
+        offset = 0;
+    }
+
+    if (!wait_space(size, block)) {
+        return nullptr;
+    }
+    reserved_ = size;
+    return data_ + offset + sizeof(RecordHeader);
+}
+
+void* NamedMessageRingBuffer::reserve_write(size_t length) {
+    return reserve(length, true);
+}
+
+void* NamedMessageRingBuffer::try_reserve_write(size_t length) {
+    return reserve(length, false);
+}
+
+void NamedMessageRingBuffer::commit_write(size_t length) {
+    if (!reserved_) {
+        throw std::logic_error("commit_write called without reserve_write");
+    }
+    size_t size = record_size(length);
+    if (size > reserved_) {
+        throw std::length_error(
+                fmt::format("commit length {} exceeds the reserved space {}", length, reserved_ - sizeof(RecordHeader)));
+    }
+
+    RecordHeader* record = reinterpret_cast<RecordHeader*>(data_ + (write_pos_ & (capacity_ - 1)));
+    record->length = length;
+    record->kind = kData;
+    write_pos_ += size;
+    reserved_ = 0;
+    publish(write_pos_);
+    header_->data_ready.ring_all();
+}
+
+void NamedMessageRingBuffer::write(const void* data, size_t length) {
+    void* buffer = reserve_write(length);
+    // 长度为0时data可以是nullptr, 而memcpy的参数即使长度为0也不能是空指针
+    if (length) {
+        memcpy(buffer, data, length);
+    }
+    commit_write(length);
+}
+
+bool NamedMessageRingBuffer::try_write(const void* data, size_t length) {
+    void* buffer = try_reserve_write(length);
+    if (!buffer) {
+        return false;
+    }
+    if (length) {
+        memcpy(buffer, data, length);
+    }
+    commit_write(length);
+    return true;
+}
+
+size_t NamedMessageRingBuffer::capacity() const {
+    return capacity_;
+}
+
+size_t NamedMessageRingBuffer::max_message_size() const {
+    return capacity_ - sizeof(RecordHeader);
+}
+
+size_t NamedMessageRingBuffer::reader_count() const {
+    size_t count = 0;
+    for (size_t i = 0; i < max_readers_; i++) {
+        if (cursor(i)->active.load(std::memory_order_acquire)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+bool NamedMessageRingBuffer::remove(const char* name) noexcept {
+    return SharedMemoryObject::remove(name);
+}
+
+MessageRingBufferReader::MessageRingBufferReader(NamedMessageRingBuffer& ring): ring_(ring) {
+    for (size_t i = 0; i < ring_.max_readers_; i++) {
+        NamedMessageRingBuffer::ReaderCursor* c = ring_.cursor(i);
+        uint32_t expected = 0;
+        if (c->active.compare_exchange_strong(expected, 1, std::memory_order_seq_cst)) {
+            cursor_ = c;
+            break;
+        }
+    }
+    if (!cursor_) {
+        throw std::runtime_error(
+                fmt::format("MessageRingBufferReader: all {} reader cursors are in use", ring_.max_readers_));
+    }
+
+    // 与写者扫描读者前的栅栏配对, 写者没有看到这个读者时写入的数据都在这里读到的写位置之前
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    read_pos_ = ring_.header_->write_pos.load(std::memory_order_acquire);
+    cursor_->read_pos.store(read_pos_, std::memory_order_release);
+    // 写者可能因为上一个读者残留的位置而在等待空间
+    ring_.header_->space_ready.ring();
+}
+
+MessageRingBufferReader::~MessageRingBufferReader() {
+    cursor_->active.store(0, std::memory_order_release);
+    ring_.header_->space_ready.ring();
+}
+
+const void* MessageRingBufferReader::next_message(size_t& length) {
+    if (peeked_) {
+        throw std::logic_error("peek_read called again before release_read");
+    }
+
+    while (true) {
+        uint64_t write_pos = ring_.header_->write_pos.load(std::memory_order_acquire);
+        if (read_pos_ == write_pos) {
+            return nullptr;
+        }
+
+        size_t offset = read_pos_ & (ring_.capacity_ - 1);
+        const RecordHeader* record = reinterpret_cast<const RecordHeader*>(ring_.data_ + offset);
+        size_t size = record_size(record->length);
+        if (record->kind == kPadding) {
+            read_pos_ += size;
+            cursor_->read_pos.store(read_pos_, std::memory_order_release);
+            ring_.header_->space_ready.ring();
+            continue;
+        }
+
+        peeked_ = size;
+        length = record->length;
+        return record + 1;
+    }
+}
+
+const void* MessageRingBufferReader::try_peek_read(size_t& length) {
+    return next_message(length);
+}
+
+const void* MessageRingBufferReader::peek_read(size_t& length) {
+    const void* data;
+    for (int i = 0; i < kSpinCount; i++) {
+        if ((data = next_message(length)) != nullptr) {
+            return data;
+        }
+        std::this_thread::yield();
+    }
+
+    InterprocessDoorbell& data_ready = ring_.header_->data_ready;
+    while (true) {
+        uint32_t seq = data_ready.prepare_wait();
+        data = next_message(length);
+        if (!data) {
+            data_ready.wait(seq);
+        }
+        data_ready.finish_wait();
+        if (data) {
+            return data;
+        }
+    }
+}
+
+void MessageRingBufferReader::release_read() {
+    if (!peeked_) {
+        throw std::logic_error("release_read called without peek_read");
+    }
+    read_pos_ += peeked_;
+    peeked_ = 0;
+    cursor_->read_pos.store(read_pos_, std::memory_order_release);
+    ring_.header_->space_ready.ring();
+}
+
+size_t MessageRingBufferReader::read(void* buffer, size_t size) {
+    size_t length;
+    const void* data = peek_read(length);
+    if (length > size) {
+        peeked_ = 0;
+        throw std::length_error(fmt::format("message length {} exceeds buffer size {}", length, size));
+    }
+    if (length) {
+        memcpy(buffer, data, length);
+    }
+    release_read();
+    return length;
+}
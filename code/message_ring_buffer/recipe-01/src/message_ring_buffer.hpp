@@ -0,0 +1,100 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdexcept>
+#include "shared_memory_object.hpp"
+
+// 共享内存中的变长消息环形缓冲区, 一个写者, 多个读者.
+// - 每条消息是一个记录: 8字节的记录头(长度+类型)加上数据, 记录按8字节对齐, 记录头不会跨越缓冲区末尾
+// - 缓冲区末尾放不下整条记录时写入一个填充记录, 从缓冲区开头继续写, 每条消息在共享内存中总是连续的
+// - 每个读者有独立的读位置, 都会读到加入之后写入的全部消息; 写者等待最慢的读者释放空间,
+//   没有读者时写入的消息直接丢弃
+// - 快速路径上只有原子操作, 写者/读者只有需要等待空间/数据时才在futex上休眠
+// - 同一时刻只能有一个写者, 崩溃的读者不会自动退出, 会一直占用它的读位置
+class NamedMessageRingBuffer {
+public:
+    // capacity向上取整为2的幂, 单条消息最大为capacity-8字节;
+    // 同名的共享内存已经存在时, capacity和max_readers必须与创建时一致
+    NamedMessageRingBuffer(const char* name, size_t capacity, size_t max_readers = 8);
+    ~NamedMessageRingBuffer();
+
+    // 写入一条消息, 空间不足时等待
+    void write(const void* data, size_t length);
+
+    // 空间不足时返回false
+    bool try_write(const void* data, size_t length);
+
+    // 零拷贝写入: 返回至少length字节的连续空间, 填充后调用commit_write发布, 实际长度可以小于length
+    void* reserve_write(size_t length);
+    void* try_reserve_write(size_t length);
+    void commit_write(size_t length);
+
+    size_t capacity() const;
+    size_t max_message_size() const;
+    size_t reader_count() const;
+
+    static bool remove(const char* name) noexcept;
+
+private:
+    NamedMessageRingBuffer(const NamedMessageRingBuffer&) = delete;
+    NamedMessageRingBuffer& operator= (const NamedMessageRingBuffer&) = delete;
+
+    friend class MessageRingBufferReader;
+
+    struct Header;
+    struct ReaderCursor;
+
+    void check_ring_buffer_valid(size_t capacity, size_t max_readers);
+    ReaderCursor* cursor(size_t i) const;
+    size_t free_space(bool refresh);
+    bool wait_space(size_t length, bool block);
+    void* reserve(size_t length, bool block);
+    void publish(uint64_t write_pos);
+
+private:
+    SharedMemoryObject shm_obj_;
+    size_t map_size_ = 0;
+    void* map_addr_ = nullptr;
+    Header* header_ = nullptr;
+    uint8_t* data_ = nullptr;
+    size_t capacity_ = 0;
+    size_t max_readers_ = 0;
+
+    // 写者的本地状态
+    uint64_t write_pos_ = 0;
+    uint64_t min_read_pos_ = 0;    // 最近一次扫描到的最慢读者的位置
+    size_t reserved_ = 0;          // reserve_write保留的记录长度, 0表示没有保留
+};
+
+// 读者在构造时占用一个读位置, 从当前的写位置开始读, 析构时释放读位置
+class MessageRingBufferReader {
+public:
+    // 读位置都被占用时抛出std::runtime_error
+    explicit MessageRingBufferReader(NamedMessageRingBuffer& ring);
+    ~MessageRingBufferReader();
+
+    // 等待并返回下一条消息的数据, 处理完后调用release_read
+    const void* peek_read(size_t& length);
+
+    // 没有消息时返回nullptr
+    const void* try_peek_read(size_t& length);
+
+    void release_read();
+
+    // 等待下一条消息并复制到buffer, 返回消息长度;
+    // buffer放不下时抛出std::length_error, 消息留在缓冲区中
+    size_t read(void* buffer, size_t size);
+
+private:
+    MessageRingBufferReader(const MessageRingBufferReader&) = delete;
+    MessageRingBufferReader& operator= (const MessageRingBufferReader&) = delete;
+
+    const void* next_message(size_t& length);
+
+private:
+    NamedMessageRingBuffer& ring_;
+    NamedMessageRingBuffer::ReaderCursor* cursor_ = nullptr;
+    uint64_t read_pos_ = 0;
+    size_t peeked_ = 0;            // peek_read返回的记录长度, 0表示没有未释放的消息
+};
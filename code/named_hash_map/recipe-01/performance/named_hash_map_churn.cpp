@@ -0,0 +1,61 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include "named_hash_map.hpp"
+
+// 会话表式的负载: 保持固定个数的活跃键, 每轮插入新键并删除最旧的键,
+// 每轮之后测量查找不存在的键的平均耗时和墓碑个数. 墓碑会在erase中自动重建回收,
+// 耗时应保持平稳而不是随轮数增长.
+//
+// 用法: named_hash_map_churn [轮数] [每轮插入/删除次数]
+
+const char* kMapName = "/named_hash_map_churn";
+const size_t kCapacity = 100000;
+const uint64_t kLiveKeys = 90000;
+
+using Map = NamedHashMap<uint64_t, uint64_t>;
+
+double miss_lookup_ns(Map& map, uint64_t first_missing) {
+    const int kLookups = 100000;
+    uint64_t found = 0;
+    uint64_t value;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kLookups; i++) {
+        found += map.find(first_missing + i * 7919, value);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    if (found) {
+        std::printf("unexpected hits: %lu\n", (unsigned long) found);
+    }
+    return elapsed.count() / kLookups;
+}
+
+int main(int argc, char* argv[]) {
+    int rounds = argc > 1 ? atoi(argv[1]) : 8;
+    uint64_t ops = argc > 2 ? strtoull(argv[2], nullptr, 10) : 200000;
+
+    Map::remove(kMapName);
+    Map map(kMapName, kCapacity);
+
+    uint64_t next = 0;
+    for (; next < kLiveKeys; next++) {
+        map.insert(next, next);
+    }
+    // 不存在的键从一个很大的偏移开始, 不会与活跃键重叠
+    const uint64_t kMissing = 1ULL << 40;
+    std::printf("round 0: miss find %.1f ns, tombstones %lu\n",
+            miss_lookup_ns(map, kMissing), (unsigned long) map.tombstone_count());
+
+    for (int round = 1; round <= rounds; round++) {
+        for (uint64_t i = 0; i < ops; i++, next++) {
+            map.insert(next, next);
+            map.erase(next - kLiveKeys);
+        }
+        std::printf("round %d: miss find %.1f ns, tombstones %lu, size %lu\n", round,
+                miss_lookup_ns(map, kMissing), (unsigned long) map.tombstone_count(), (unsigned long) map.size());
+    }
+
+    Map::remove(kMapName);
+    return 0;
+}
@@ -0,0 +1,155 @@
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+#include "named_hash_map.hpp"
+
+// 多个读者进程同时查找NamedHashMap, 一个写者进程不断更新, 输出所有读者的查找速率.
+// 对比读者不加锁的查找和所有进程共用一把InterprocessMutex的查找.
+//
+// 用法: named_hash_map_lookup [最多读者进程数] [测试时长ms]
+
+const char* kMapName = "/named_hash_map_lookup";
+const char* kLockName = "/named_hash_map_lookup_lock";
+const size_t kCapacity = 1 << 16;
+const uint64_t kKeyCount = 1 << 15;
+
+struct Value {
+    uint64_t key;
+    uint64_t payload[3];
+};
+
+struct GlobalLock {
+    InterprocessOnceFlag once_flag;
+    InterprocessMutex mutex;
+};
+
+using Map = NamedHashMap<uint64_t, Value>;
+
+// 返回查找次数
+uint64_t read_loop(bool locked, std::chrono::steady_clock::time_point deadline, int seed) {
+    Map map(kMapName, kCapacity);
+    SharedMemoryObject lock_obj = SharedMemoryObject::open_read_write(kLockName);
+    GlobalLock* lock = static_cast<GlobalLock*>(lock_obj.map(sizeof(GlobalLock)));
+
+    uint64_t lookups = 0;
+    uint64_t key = seed;
+    while (std::chrono::steady_clock::now() < deadline) {
+        for (int i = 0; i < 1000; i++) {
+            key = (key * 6364136223846793005ULL + 1442695040888963407ULL);
+            Value value;
+            if (locked) {
+                std::lock_guard<InterprocessMutex> guard(lock->mutex);
+                map.find(key % kKeyCount, value);
+            } else {
+                map.find(key % kKeyCount, value);
+            }
+        }
+        lookups += 1000;
+    }
+    SharedMemoryObject::unmap(lock, sizeof(GlobalLock));
+    return lookups;
+}
+
+void write_loop(bool locked, std::chrono::steady_clock::time_point deadline) {
+    Map map(kMapName, kCapacity);
+    SharedMemoryObject lock_obj = SharedMemoryObject::open_read_write(kLockName);
+    GlobalLock* lock = static_cast<GlobalLock*>(lock_obj.map(sizeof(GlobalLock)));
+
+    uint64_t generation = 0;
+    while (std::chrono::steady_clock::now() < deadline) {
+        generation++;
+        for (uint64_t key = 0; key < kKeyCount && std::chrono::steady_clock::now() < deadline; key += 64) {
+            Value value = {key, {generation, generation, generation}};
+            if (locked) {
+                std::lock_guard<InterprocessMutex> guard(lock->mutex);
+                map.insert_or_assign(key, value);
+            } else {
+                map.insert_or_assign(key, value);
+            }
+        }
+    }
+    SharedMemoryObject::unmap(lock, sizeof(GlobalLock));
+}
+
+void run(const char* title, bool locked, int readers, int duration_ms) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(duration_ms);
+    std::vector<int> pipes;
+    std::vector<pid_t> children;
+    for (int i = 0; i < readers; i++) {
+        int fds[2];
+        if (pipe(fds) != 0) {
+            perror("pipe");
+            exit(1);
+        }
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(fds[0]);
+            uint64_t lookups = read_loop(locked, deadline, i + 1);
+            if (write(fds[1], &lookups, sizeof(lookups)) != sizeof(lookups)) {
+                perror("write");
+            }
+            _exit(0);
+        }
+        close(fds[1]);
+        pipes.push_back(fds[0]);
+        children.push_back(pid);
+    }
+
+    pid_t writer = fork();
+    if (writer == 0) {
+        write_loop(locked, deadline);
+        _exit(0);
+    }
+    children.push_back(writer);
+
+    uint64_t total = 0;
+    for (int fd: pipes) {
+        uint64_t lookups = 0;
+        if (read(fd, &lookups, sizeof(lookups)) == sizeof(lookups)) {
+            total += lookups;
+        }
+        close(fd);
+    }
+    for (pid_t pid: children) {
+        waitpid(pid, nullptr, 0);
+    }
+    printf("%-12s readers %2d: %8.2f M lookups/s\n", title, readers, total / (duration_ms / 1000.0) / 1e6);
+}
+
+int main(int argc, char* argv[]) {
+    int max_readers = argc > 1 ? atoi(argv[1]) : (int) std::thread::hardware_concurrency();
+    int duration_ms = argc > 2 ? atoi(argv[2]) : 500;
+    if (max_readers < 1) {
+        max_readers = 1;
+    }
+
+    Map::remove(kMapName);
+    SharedMemoryObject::remove(kLockName);
+    Map map(kMapName, kCapacity);
+    for (uint64_t key = 0; key < kKeyCount; key++) {
+        map.insert(key, Value{key, {0, 0, 0}});
+    }
+    SharedMemoryObject lock_obj = SharedMemoryObject::open_or_create(kLockName);
+    lock_obj.truncate(sizeof(GlobalLock));
+    GlobalLock* lock = static_cast<GlobalLock*>(lock_obj.map(sizeof(GlobalLock)));
+    interprocess_call_once(lock->once_flag, [lock]() {
+            new (&lock->mutex) InterprocessMutex();
+            });
+
+    for (int readers = 1; readers <= max_readers; readers *= 2) {
+        run("lock-free", false, readers, duration_ms);
+        run("mutex", true, readers, duration_ms);
+    }
+
+    SharedMemoryObject::unmap(lock, sizeof(GlobalLock));
+    Map::remove(kMapName);
+    SharedMemoryObject::remove(kLockName);
+}
@@ -0,0 +1,98 @@
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include "named_hash_map.hpp"
+
+using namespace std::literals;
+
+const char* kMapName = "/sample_routing_table";
+const size_t kCapacity = 4096;
+const uint32_t kRouteCount = 1000;
+const size_t kReaderCount = 3;
+
+// 写者更新路由时整体替换Route, 读者据此检查读到的值是否完整
+struct Route {
+    uint32_t destination;
+    uint32_t next_hop;
+    uint64_t generation;
+    uint64_t check;
+};
+
+Route make_route(uint32_t destination, uint64_t generation) {
+    Route route;
+    route.destination = destination;
+    route.next_hop = (uint32_t) (destination * 7 + generation);
+    route.generation = generation;
+    route.check = route.destination ^ route.next_hop ^ route.generation;
+    return route;
+}
+
+bool check_route(uint32_t destination, const Route& route) {
+    return route.destination == destination && route.check == (route.destination ^ route.next_hop ^ route.generation);
+}
+
+void reader(int id) {
+    NamedHashMap<uint32_t, Route> routes(kMapName, kCapacity);
+    size_t lookups = 0;
+    size_t found = 0;
+    size_t errors = 0;
+    auto deadline = std::chrono::steady_clock::now() + 500ms;
+    while (std::chrono::steady_clock::now() < deadline) {
+        for (uint32_t destination = 0; destination < kRouteCount; destination++) {
+            Route route;
+            lookups++;
+            if (routes.find(destination, route)) {
+                found++;
+                if (!check_route(destination, route)) {
+                    errors++;
+                }
+            }
+        }
+    }
+    std::cout << "reader " << id << ": " << lookups << " lookups, " << found << " found, "
+        << errors << " errors" << std::endl;
+}
+
+int main() {
+    NamedHashMap<uint32_t, Route>::remove(kMapName);
+    NamedHashMap<uint32_t, Route> routes(kMapName, kCapacity);
+    for (uint32_t destination = 0; destination < kRouteCount; destination++) {
+        routes.insert(destination, make_route(destination, 0));
+    }
+    std::cout << "writer: " << routes.size() << " routes, " << routes.bucket_count() << " buckets" << std::endl;
+
+    std::vector<pid_t> children;
+    for (size_t i = 0; i < kReaderCount; i++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            reader(i);
+            return 0;
+        }
+        children.push_back(pid);
+    }
+
+    // 读者查找的同时不断更新/删除/重新插入路由
+    uint64_t generation = 0;
+    auto deadline = std::chrono::steady_clock::now() + 500ms;
+    while (std::chrono::steady_clock::now() < deadline) {
+        generation++;
+        for (uint32_t destination = 0; destination < kRouteCount; destination++) {
+            if (destination % 10 == generation % 10) {
+                routes.erase(destination);
+                routes.insert(destination, make_route(destination, generation));
+            } else {
+                routes.insert_or_assign(destination, make_route(destination, generation));
+            }
+        }
+    }
+    std::cout << "writer: " << generation << " generations, " << routes.size() << " routes" << std::endl;
+
+    for (pid_t pid: children) {
+        waitpid(pid, nullptr, 0);
+    }
+    NamedHashMap<uint32_t, Route>::remove(kMapName);
+}
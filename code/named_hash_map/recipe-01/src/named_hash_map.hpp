@@ -0,0 +1,433 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "shared_memory_object.hpp"
+#include "interprocess_once.hpp"
+#include "interprocess_mutex.hpp"
+
+#define FMT_HEADER_ONLY
+#include "fmt/format.h"
+
+#define NAMED_HASH_MAP_MAGIC 0x6e686d71
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "atomic<uint32_t> need lock free");
+
+// 共享内存中的开放寻址(线性探测)哈希表, 容量在创建时确定, 不能扩容.
+// - 每个桶有一个版本号(seqlock, 写入中为奇数), 读者复制桶的内容前后各检查一次版本号,
+//   读操作不加锁, 不写共享内存, 多个进程可以同时查找
+// - 写者按键的哈希值选择一把条带锁(InterprocessMutex), 同一个键的写操作互斥, 不同条带的写者可以同时进行;
+//   修改桶时通过CAS把版本号改为奇数, 两个写者不会同时修改同一个桶
+// - 删除留下墓碑, 插入时重用; 桶的个数是容量的2倍以上, 探测序列较短.
+//   墓碑不会自己变回空桶, 墓碑数达到桶数的1/4时erase在所有条带锁下原地重建(rehash),
+//   重建期间header中的generation为奇数, 读者等待重建完成后重新查找
+// - Key和Value必须可以平凡复制, 只能用==比较键
+// - 写者在修改桶的过程中崩溃时, 读者会一直等待这个桶
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class NamedHashMap {
+public:
+    static_assert(std::is_trivially_copyable<Key>::value, "Key must be trivially copyable to live in shared memory");
+    static_assert(std::is_trivially_copyable<Value>::value, "Value must be trivially copyable to live in shared memory");
+
+    // 同名的共享内存已经存在时, capacity必须与创建时一致
+    NamedHashMap(const char* name, size_t capacity):
+        shm_obj_(SharedMemoryObject::open_or_create(name)), capacity_(capacity) {
+        if (capacity_ == 0) {
+            throw std::invalid_argument("NamedHashMap capacity must be positive");
+        }
+
+        bucket_count_ = 1;
+        while (bucket_count_ < capacity_ * 2) {
+            bucket_count_ <<= 1;
+        }
+        map_size_ = sizeof(Header) + bucket_count_ * sizeof(Bucket);
+        if (shm_obj_.size() < map_size_) {
+            shm_obj_.truncate(map_size_);
+        }
+        map_addr_ = shm_obj_.map(map_size_);
+        header_ = static_cast<Header*>(map_addr_);
+        buckets_ = reinterpret_cast<Bucket*>(header_ + 1);
+
+        try {
+            interprocess_call_once(header_->once_flag, [this]() {
+                    header_->magic = NAMED_HASH_MAP_MAGIC;
+                    header_->key_size = sizeof(Key);
+                    header_->value_size = sizeof(Value);
+                    header_->capacity = capacity_;
+                    new (&header_->size) std::atomic<uint64_t>(0);
+                    new (&header_->tombstones) std::atomic<uint64_t>(0);
+                    new (&header_->generation) std::atomic<uint32_t>(0);
+                    for (size_t i = 0; i < kLockCount; i++) {
+                        new (&header_->locks[i]) InterprocessMutex();
+                    }
+                    for (size_t i = 0; i < bucket_count_; i++) {
+                        new (&buckets_[i].version) std::atomic<uint32_t>(0);
+                        buckets_[i].state = kEmpty;
+                    }
+                    });
+            check_hash_map_valid();
+        } catch (...) {
+            SharedMemoryObject::unmap(map_addr_, map_size_);
+            throw;
+        }
+    }
+
+    ~NamedHashMap() {
+        SharedMemoryObject::unmap(map_addr_, map_size_);
+    }
+
+    // 不加锁, 找到时把值复制到value; 查找期间发生了重建时重新查找
+    bool find(const Key& key, Value& value) const {
+        size_t hash = hash_of(key);
+        while (true) {
+            uint32_t generation = header_->generation.load(std::memory_order_acquire);
+            if (generation & 1) {
+                std::this_thread::yield();
+                continue;
+            }
+            Snapshot snapshot;
+            bool found = probe(key, hash, snapshot);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (header_->generation.load(std::memory_order_relaxed) == generation) {
+                if (found) {
+                    value = snapshot.value;
+                }
+                return found;
+            }
+        }
+    }
+
+    bool contains(const Key& key) const {
+        Value value;
+        return find(key, value);
+    }
+
+    // 键已经存在时不修改, 返回false; 元素个数达到容量时抛出std::length_error
+    bool insert(const Key& key, const Value& value) {
+        return put(key, value, false);
+    }
+
+    // 键已经存在时更新值并返回false, 否则插入并返回true
+    bool insert_or_assign(const Key& key, const Value& value) {
+        return put(key, value, true);
+    }
+
+    // 墓碑过多时释放条带锁之后重建
+    bool erase(const Key& key) {
+        size_t hash = hash_of(key);
+        {
+            std::lock_guard<InterprocessMutex> lock(stripe_lock(hash));
+            Bucket* bucket = locate(key, hash, nullptr);
+            if (bucket == nullptr) {
+                return false;
+            }
+            uint32_t version = lock_bucket(*bucket);
+            bucket->state = kDeleted;
+            unlock_bucket(*bucket, version);
+            header_->size.fetch_sub(1, std::memory_order_relaxed);
+            header_->tombstones.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (too_many_tombstones()) {
+            rehash(true);
+        }
+        return true;
+    }
+
+    // 在所有条带锁下原地重建, 把墓碑变回空桶并缩短探测序列; 耗时与桶的个数成正比,
+    // 期间写者阻塞, 读者等待. erase会自动调用, 也可以在负载低的时候主动调用
+    void rehash() {
+        rehash(false);
+    }
+
+    size_t size() const {
+        return header_->size.load(std::memory_order_relaxed);
+    }
+
+    // 删除留下的墓碑个数, 重建后清零
+    size_t tombstone_count() const {
+        return header_->tombstones.load(std::memory_order_relaxed);
+    }
+
+    size_t capacity() const {
+        return capacity_;
+    }
+
+    size_t bucket_count() const {
+        return bucket_count_;
+    }
+
+    static bool remove(const char* name) noexcept {
+        return SharedMemoryObject::remove(name);
+    }
+
+private:
+    NamedHashMap(const NamedHashMap&) = delete;
+    NamedHashMap& operator= (const NamedHashMap&) = delete;
+
+    static constexpr size_t kCacheLineSize = 64;
+    static constexpr size_t kLockCount = 64;
+
+    enum State: uint32_t {
+        kEmpty = 0,
+        kOccupied = 1,
+        kDeleted = 2,
+    };
+
+    struct Header {
+        InterprocessOnceFlag once_flag;
+        uint32_t magic;
+        uint64_t key_size;
+        uint64_t value_size;
+        uint64_t capacity;
+        alignas(kCacheLineSize) std::atomic<uint64_t> size;
+        std::atomic<uint64_t> tombstones;
+        // 重建期间为奇数, 与桶的版本号一样是seqlock, 读者据此判断查找期间是否发生了重建
+        alignas(kCacheLineSize) std::atomic<uint32_t> generation;
+        alignas(kCacheLineSize) InterprocessMutex locks[kLockCount];
+    };
+
+    struct Bucket {
+        std::atomic<uint32_t> version;
+        uint32_t state;
+        Key key;
+        Value value;
+    };
+
+    struct Snapshot {
+        uint32_t state;
+        Key key;
+        Value value;
+    };
+
+    // 混合哈希值的各位, std::hash对整数是恒等函数, 直接取低位容易冲突
+    size_t hash_of(const Key& key) const {
+        uint64_t h = Hash()(key);
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    InterprocessMutex& stripe_lock(size_t hash) const {
+        return header_->locks[(hash >> 32) & (kLockCount - 1)];
+    }
+
+    static void read_bucket(const Bucket& bucket, Snapshot& snapshot) {
+        while (true) {
+            uint32_t version = bucket.version.load(std::memory_order_acquire);
+            if (version & 1) {
+                std::this_thread::yield();
+                continue;
+            }
+            snapshot.state = bucket.state;
+            std::memcpy(static_cast<void*>(&snapshot.key), &bucket.key, sizeof(Key));
+            std::memcpy(static_cast<void*>(&snapshot.value), &bucket.value, sizeof(Value));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (bucket.version.load(std::memory_order_relaxed) == version) {
+                return;
+            }
+        }
+    }
+
+    // 把版本号改为奇数, 其他写者不能同时修改这个桶, 读者会等待
+    static uint32_t lock_bucket(Bucket& bucket) {
+        while (true) {
+            uint32_t version = bucket.version.load(std::memory_order_relaxed);
+            if (!(version & 1) && bucket.version.compare_exchange_weak(version, version + 1, std::memory_order_acquire)) {
+                std::atomic_thread_fence(std::memory_order_release);
+                return version;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    static void unlock_bucket(Bucket& bucket, uint32_t version) {
+        bucket.version.store(version + 2, std::memory_order_release);
+    }
+
+    bool too_many_tombstones() const {
+        return header_->tombstones.load(std::memory_order_relaxed) >= bucket_count_ / 4;
+    }
+
+    // 沿探测序列查找key, 不加锁
+    bool probe(const Key& key, size_t hash, Snapshot& snapshot) const {
+        for (size_t i = 0; i < bucket_count_; i++) {
+            const Bucket& bucket = buckets_[(hash + i) & (bucket_count_ - 1)];
+            read_bucket(bucket, snapshot);
+            if (snapshot.state == kEmpty) {
+                return false;
+            }
+            if (snapshot.state == kOccupied && snapshot.key == key) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // if_needed为true时, 拿到所有条带锁之后墓碑已经不多(其他进程刚重建过)就不再重建.
+    // 条带锁按下标顺序加锁, 写者只持有一把条带锁, 不会死锁
+    void rehash(bool if_needed) {
+        std::vector<std::pair<Key, Value>> entries;
+        entries.reserve(capacity_);     // 加锁之后不再分配内存, 不会在持有锁时抛出异常
+        for (size_t i = 0; i < kLockCount; i++) {
+            header_->locks[i].lock();
+        }
+        if (!if_needed || too_many_tombstones()) {
+            rehash_locked(entries);
+        }
+        for (size_t i = kLockCount; i > 0; i--) {
+            header_->locks[i - 1].unlock();
+        }
+    }
+
+    void rehash_locked(std::vector<std::pair<Key, Value>>& entries) {
+        header_->generation.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t i = 0; i < bucket_count_; i++) {
+            Bucket& bucket = buckets_[i];
+            if (bucket.state == kOccupied) {
+                entries.emplace_back(bucket.key, bucket.value);
+            }
+            if (bucket.state != kEmpty) {
+                uint32_t version = lock_bucket(bucket);
+                bucket.state = kEmpty;
+                unlock_bucket(bucket, version);
+            }
+        }
+        for (auto& entry: entries) {
+            size_t hash = hash_of(entry.first);
+            for (size_t i = 0; i < bucket_count_; i++) {
+                Bucket& bucket = buckets_[(hash + i) & (bucket_count_ - 1)];
+                if (bucket.state == kEmpty) {
+                    uint32_t version = lock_bucket(bucket);
+                    std::memcpy(static_cast<void*>(&bucket.key), &entry.first, sizeof(Key));
+                    std::memcpy(static_cast<void*>(&bucket.value), &entry.second, sizeof(Value));
+                    bucket.state = kOccupied;
+                    unlock_bucket(bucket, version);
+                    break;
+                }
+            }
+        }
+        header_->tombstones.store(0, std::memory_order_relaxed);
+
+        header_->generation.fetch_add(1, std::memory_order_release);
+    }
+
+    // 调用者持有键所在条带的锁, 其他写者不会插入或删除这个键, 桶中的键可以直接读取;
+    // free_bucket非空时返回探测序列中第一个空桶或墓碑, 没有时为nullptr
+    Bucket* locate(const Key& key, size_t hash, Bucket** free_bucket) const {
+        if (free_bucket) {
+            *free_bucket = nullptr;
+        }
+        for (size_t i = 0; i < bucket_count_; i++) {
+            Bucket& bucket = buckets_[(hash + i) & (bucket_count_ - 1)];
+            Snapshot snapshot;
+            read_bucket(bucket, snapshot);
+            if (snapshot.state == kOccupied) {
+                if (snapshot.key == key) {
+                    return &bucket;
+                }
+                continue;
+            }
+            if (free_bucket && *free_bucket == nullptr) {
+                *free_bucket = &bucket;
+            }
+            if (snapshot.state == kEmpty) {
+                return nullptr;
+            }
+        }
+        return nullptr;
+    }
+
+    bool put(const Key& key, const Value& value, bool assign) {
+        size_t hash = hash_of(key);
+        std::lock_guard<InterprocessMutex> lock(stripe_lock(hash));
+        Bucket* free_bucket;
+        Bucket* bucket = locate(key, hash, &free_bucket);
+        if (bucket) {
+            if (assign) {
+                uint32_t version = lock_bucket(*bucket);
+                std::memcpy(static_cast<void*>(&bucket->value), &value, sizeof(Value));
+                unlock_bucket(*bucket, version);
+            }
+            return false;
+        }
+
+        if (header_->size.fetch_add(1, std::memory_order_relaxed) >= capacity_) {
+            header_->size.fetch_sub(1, std::memory_order_relaxed);
+            throw std::length_error(fmt::format("NamedHashMap is full, capacity {}", capacity_));
+        }
+
+        // 其他条带的写者可能先占用了这个空桶, 从这里继续向后找
+        size_t index = free_bucket ? free_bucket - buckets_ : (hash & (bucket_count_ - 1));
+        for (size_t i = 0; i < bucket_count_; i++) {
+            Bucket& candidate = buckets_[(index + i) & (bucket_count_ - 1)];
+            uint32_t version = lock_bucket(candidate);
+            if (candidate.state != kOccupied) {
+                if (candidate.state == kDeleted) {
+                    header_->tombstones.fetch_sub(1, std::memory_order_relaxed);
+                }
+                std::memcpy(static_cast<void*>(&candidate.key), &key, sizeof(Key));
+                std::memcpy(static_cast<void*>(&candidate.value), &value, sizeof(Value));
+                candidate.state = kOccupied;
+                unlock_bucket(candidate, version);
+                return true;
+            }
+            // 没有修改, 恢复原来的版本号
+            candidate.version.store(version, std::memory_order_release);
+        }
+        header_->size.fetch_sub(1, std::memory_order_relaxed);
+        throw std::length_error(fmt::format("NamedHashMap has no free bucket, capacity {}", capacity_));
+    }
+
+    void check_hash_map_valid() {
+        if (header_->magic != NAMED_HASH_MAP_MAGIC) {
+            throw std::runtime_error(
+                    fmt::format("check_hash_map_valid failed, invalid magic: expect [{}], in fact [{}] ",
+                        NAMED_HASH_MAP_MAGIC, header_->magic)
+                    );
+        }
+
+        if (header_->key_size != sizeof(Key)) {
+            throw std::runtime_error(
+                    fmt::format("check_hash_map_valid failed, invalid key size: expect [{}], in fact [{}] ",
+                        sizeof(Key), header_->key_size)
+                    );
+        }
+
+        if (header_->value_size != sizeof(Value)) {
+            throw std::runtime_error(
+                    fmt::format("check_hash_map_valid failed, invalid value size: expect [{}], in fact [{}] ",
+                        sizeof(Value), header_->value_size)
+                    );
+        }
+
+        if (header_->capacity != capacity_) {
+            throw std::runtime_error(
+                    fmt::format("check_hash_map_valid failed, invalid capacity: expect [{}], in fact [{}] ",
+                        capacity_, header_->capacity)
+                    );
+        }
+    }
+
+private:
+    SharedMemoryObject shm_obj_;
+    size_t capacity_ = 0;
+    size_t bucket_count_ = 0;
+    size_t map_size_ = 0;
+    void* map_addr_ = nullptr;
+    Header* header_ = nullptr;
+    Bucket* buckets_ = nullptr;
+};
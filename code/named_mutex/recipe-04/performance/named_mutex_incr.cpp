@@ -0,0 +1,104 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <mutex>
+#include <string>
+#include <system_error>
+#include "named_mutex.hpp"
+
+#include "benchmark/benchmark.h"
+
+#define REPEAT2(x) x x
+#define REPEAT4(x) REPEAT2(x) REPEAT2(x)
+#define REPEAT8(x) REPEAT4(x) REPEAT4(x)
+#define REPEAT16(x) REPEAT8(x) REPEAT8(x)
+#define REPEAT32(x) REPEAT16(x) REPEAT16(x)
+#define REPEAT(x) REPEAT32(x)
+
+// 版本三之前的InterprocessMutex: PTHREAD_PROCESS_SHARED的pthread mutex
+class PthreadSharedMutex {
+public:
+    PthreadSharedMutex() {
+        pthread_mutexattr_t attr;
+        pthread_mutexattr_init(&attr);
+        pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+        int n = pthread_mutex_init(&mtx_, &attr);
+        pthread_mutexattr_destroy(&attr);
+        if (n != 0) {
+            throw std::system_error(n, std::system_category(), "pthread_mutex_init error");
+        }
+    }
+
+    ~PthreadSharedMutex() {
+        pthread_mutex_destroy(&mtx_);
+    }
+
+    void lock() { pthread_mutex_lock(&mtx_); }
+    void unlock() { pthread_mutex_unlock(&mtx_); }
+
+private:
+    pthread_mutex_t mtx_;
+};
+
+// 统一各种互斥量的构造方式, NamedMutex需要名字
+template <typename Mutex>
+struct MutexFactory {
+    static Mutex* create(const std::string&) { return new Mutex(); }
+};
+
+template <>
+struct MutexFactory<NamedMutex> {
+    static NamedMutex* create(const std::string& name) { return new NamedMutex(name.c_str()); }
+};
+
+// 所有线程共用一把锁
+template <typename Mutex>
+void BM_mutex(benchmark::State& state) {
+    static unsigned long x {0};
+    static Mutex* m = MutexFactory<Mutex>::create("mtx");
+    for (auto _ : state) {
+        REPEAT(
+            {
+                std::lock_guard<Mutex> g(*m);
+                benchmark::DoNotOptimize(++x);
+            }
+        );
+    }
+    state.SetItemsProcessed(32*32*state.iterations());
+}
+
+// 每个线程一把锁, 没有竞争
+template <typename Mutex>
+void BM_mutex0(benchmark::State& state) {
+    unsigned long x {0};
+    std::string mtx_name = "mtx"+std::to_string(state.thread_index());
+    Mutex* m = MutexFactory<Mutex>::create(mtx_name);
+    for (auto _ : state) {
+        REPEAT(
+            {
+                std::lock_guard<Mutex> g(*m);
+                benchmark::DoNotOptimize(++x);
+            }
+        );
+    }
+    state.SetItemsProcessed(32*32*state.iterations());
+    delete m;
+}
+
+static const long numcpu = sysconf(_SC_NPROCESSORS_CONF);
+#define ARG \
+    ->ThreadRange(1, numcpu) \
+    ->UseRealTime()
+
+BENCHMARK_TEMPLATE(BM_mutex, std::mutex) ARG;
+BENCHMARK_TEMPLATE(BM_mutex, PthreadSharedMutex) ARG;
+BENCHMARK_TEMPLATE(BM_mutex, InterprocessMutex) ARG;
+BENCHMARK_TEMPLATE(BM_mutex, NamedMutex) ARG;
+BENCHMARK_TEMPLATE(BM_mutex0, std::mutex) ARG;
+BENCHMARK_TEMPLATE(BM_mutex0, PthreadSharedMutex) ARG;
+BENCHMARK_TEMPLATE(BM_mutex0, InterprocessMutex) ARG;
+BENCHMARK_TEMPLATE(BM_mutex0, NamedMutex) ARG;
+
+BENCHMARK_MAIN();
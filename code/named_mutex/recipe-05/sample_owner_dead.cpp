@@ -0,0 +1,77 @@
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include "named_mutex.hpp"
+
+using namespace std::literals;
+
+const char* kMutexName = "sample_robust_mtx";
+const char* kDataName = "sample_robust_data";
+
+// 受互斥量保护的数据, 两个字段必须相等
+struct Account {
+    long balance;
+    long shadow;
+};
+
+int main() {
+    NamedMutex::remove(kMutexName);
+    SharedMemoryObject::remove(kDataName);
+    NamedMutex mutex(kMutexName);
+    SharedMemory<Account> data(kDataName);
+
+    // 子进程修改数据到一半时崩溃, 没有解锁
+    pid_t pid = fork();
+    if (pid == 0) {
+        NamedMutex child_mutex(kMutexName);
+        SharedMemory<Account> child_data(kDataName);
+        child_mutex.lock();
+        child_data.get().balance += 100;
+        _exit(1);
+    }
+    waitpid(pid, nullptr, 0);
+
+    auto start = std::chrono::steady_clock::now();
+    if (!mutex.try_lock_for(100ms)) {
+        std::cout << "try_lock_for timeout" << std::endl;
+        return 1;
+    }
+    std::chrono::duration<double, std::micro> recovery = std::chrono::steady_clock::now() - start;
+    std::cout << "locked after " << recovery.count() << " us, owner died: " << std::boolalpha << mutex.owner_died() << std::endl;
+    if (mutex.owner_died()) {
+        Account& account = data.get();
+        std::cout << "repair account: balance " << account.balance << ", shadow " << account.shadow << std::endl;
+        account.balance = account.shadow;
+        mutex.consistent();
+    }
+    mutex.unlock();
+
+    // 子进程持有锁200ms, 父进程的try_lock_for(50ms)超时
+    pid = fork();
+    if (pid == 0) {
+        NamedMutex child_mutex(kMutexName);
+        std::lock_guard<NamedMutex> lock(child_mutex);
+        std::this_thread::sleep_for(200ms);
+        return 0;
+    }
+    while (mutex.owner() != pid) {
+        std::this_thread::sleep_for(1ms);
+    }
+    std::cout << "try_lock_for(50ms) while held by " << pid << ": " << mutex.try_lock_for(50ms) << std::endl;
+    mutex.lock();
+    NamedMutexStats stats = mutex.stats();
+    mutex.unlock();
+    waitpid(pid, nullptr, 0);
+
+    std::cout << "locks " << stats.lock_count << ", contended " << stats.contended_count
+        << ", owner dead " << stats.owner_dead_count
+        << ", max wait " << stats.max_wait_ns / 1000 << " us"
+        << ", max hold " << stats.max_hold_ns / 1000 << " us" << std::endl;
+
+    NamedMutex::remove(kMutexName);
+    SharedMemoryObject::remove(kDataName);
+}
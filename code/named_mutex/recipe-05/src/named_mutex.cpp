@@ -0,0 +1,180 @@
+#include "named_mutex.hpp"
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <system_error>
+
+namespace {
+
+struct RobustMutexAttr {
+    RobustMutexAttr() {
+        int n;
+        n = pthread_mutexattr_init(&attr);
+        if (n != 0) {
+            throw std::system_error(n, std::system_category(), "pthread_mutexattr_init error");
+        }
+
+        n = pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+        if (n != 0) {
+            pthread_mutexattr_destroy(&attr);
+            throw std::system_error(n, std::system_category(), "pthread_mutexattr_setpshared error");
+        }
+
+        n = pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+        if (n != 0) {
+            pthread_mutexattr_destroy(&attr);
+            throw std::system_error(n, std::system_category(), "pthread_mutexattr_setrobust error");
+        }
+    }
+
+    ~RobustMutexAttr()  {  pthread_mutexattr_destroy(&attr);  }
+
+    pthread_mutexattr_t* native_handle() { return &attr; }
+
+    pthread_mutexattr_t attr;
+};
+
+int64_t now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+}   // namespace
+
+NamedMutex::NamedMutex(const char* name): impl_(name) {
+    Impl* impl = &impl_.get();
+    interprocess_call_once(impl->once_flag, [impl]() {
+            RobustMutexAttr attr;
+            int n = pthread_mutex_init(&impl->mutex, attr.native_handle());
+            if (n != 0) {
+                throw std::system_error(n, std::system_category(), "pthread_mutex_init error");
+            }
+            new (&impl->owner) std::atomic<pid_t>(0);
+            impl->lock_time_ns = 0;
+            impl->stats = NamedMutexStats();
+            });
+}
+
+NamedMutex::~NamedMutex() {
+}
+
+void NamedMutex::lock() {
+    Impl& impl = impl_.get();
+    int n = pthread_mutex_trylock(&impl.mutex);
+    if (n != EBUSY) {
+        on_locked(n, 0, false);
+        return;
+    }
+
+    int64_t start_ns = now_ns();
+    n = pthread_mutex_lock(&impl.mutex);
+    on_locked(n, start_ns, true);
+}
+
+bool NamedMutex::try_lock() {
+    Impl& impl = impl_.get();
+    int n = pthread_mutex_trylock(&impl.mutex);
+    if (n == EBUSY) {
+        return false;
+    }
+    on_locked(n, 0, false);
+    return true;
+}
+
+bool NamedMutex::timed_lock(int64_t deadline_ns) {
+    Impl& impl = impl_.get();
+    int n = pthread_mutex_trylock(&impl.mutex);
+    if (n != EBUSY) {
+        on_locked(n, 0, false);
+        return true;
+    }
+
+    int64_t start_ns = now_ns();
+    struct timespec deadline;
+    deadline.tv_sec = deadline_ns / 1000000000LL;
+    deadline.tv_nsec = deadline_ns % 1000000000LL;
+    n = pthread_mutex_clocklock(&impl.mutex, CLOCK_MONOTONIC, &deadline);
+    if (n == ETIMEDOUT) {
+        return false;
+    }
+    on_locked(n, start_ns, true);
+    return true;
+}
+
+// 已经持有锁(或者加锁失败), 更新持有者和统计数据
+void NamedMutex::on_locked(int error, int64_t start_ns, bool contended) {
+    if (error != 0 && error != EOWNERDEAD) {
+        throw std::system_error(error, std::system_category(), "pthread_mutex_lock error");
+    }
+
+    Impl& impl = impl_.get();
+    int64_t locked_ns = now_ns();
+    owner_died_ = (error == EOWNERDEAD);
+    impl.owner.store(getpid(), std::memory_order_relaxed);
+    impl.lock_time_ns = locked_ns;
+
+    NamedMutexStats& stats = impl.stats;
+    stats.lock_count++;
+    if (owner_died_) {
+        stats.owner_dead_count++;
+    }
+    if (contended) {
+        uint64_t wait_ns = locked_ns - start_ns;
+        stats.contended_count++;
+        stats.total_wait_ns += wait_ns;
+        if (wait_ns > stats.max_wait_ns) {
+            stats.max_wait_ns = wait_ns;
+        }
+    }
+}
+
+void NamedMutex::unlock() {
+    Impl& impl = impl_.get();
+    uint64_t hold_ns = now_ns() - impl.lock_time_ns;
+    impl.stats.total_hold_ns += hold_ns;
+    if (hold_ns > impl.stats.max_hold_ns) {
+        impl.stats.max_hold_ns = hold_ns;
+    }
+    impl.owner.store(0, std::memory_order_relaxed);
+    owner_died_ = false;
+
+    int n = pthread_mutex_unlock(&impl.mutex);
+    if (n != 0) {
+        throw std::system_error(n, std::system_category(), "pthread_mutex_unlock error");
+    }
+}
+
+bool NamedMutex::owner_died() const {
+    return owner_died_;
+}
+
+void NamedMutex::consistent() {
+    int n = pthread_mutex_consistent(&impl_.get().mutex);
+    if (n != 0) {
+        throw std::system_error(n, std::system_category(), "pthread_mutex_consistent error");
+    }
+    owner_died_ = false;
+}
+
+pid_t NamedMutex::owner() const {
+    return impl_.get().owner.load(std::memory_order_relaxed);
+}
+
+NamedMutexStats NamedMutex::stats() {
+    return impl_.get().stats;
+}
+
+void NamedMutex::reset_stats() {
+    Impl& impl = impl_.get();
+    impl.stats = NamedMutexStats();
+    impl.lock_time_ns = now_ns();
+}
+
+pthread_mutex_t* NamedMutex::native_handle() {
+    return &impl_.get().mutex;
+}
+
+bool NamedMutex::remove(const char* name) {
+    return SharedMemoryObject::remove(name); 
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <pthread.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <atomic>
+#include <chrono>
+#include "shared_memory.hpp"
+#include "interprocess_once.hpp"
+
+// 加锁/持有时间的统计, 保存在共享内存中, 包含所有进程的数据
+struct NamedMutexStats {
+    uint64_t lock_count = 0;            // 成功加锁的次数
+    uint64_t contended_count = 0;       // 加锁时需要等待的次数
+    uint64_t owner_dead_count = 0;      // 持有者崩溃后被其他进程接管的次数
+    uint64_t total_wait_ns = 0;         // 需要等待时的等待时间总和
+    uint64_t max_wait_ns = 0;
+    uint64_t total_hold_ns = 0;         // 从加锁成功到解锁的时间总和
+    uint64_t max_hold_ns = 0;
+};
+
+// 基于健壮(PTHREAD_MUTEX_ROBUST)的进程间pthread mutex.
+// 持有锁的进程崩溃后, 下一个加锁的进程仍然拿到锁, 同时owner_died()返回true:
+// - 受保护的数据可能只修改了一半, 修复后调用consistent(), 之后互斥量恢复正常
+// - 不调用consistent()就解锁时, 互斥量永久不可用, 之后的加锁抛出std::system_error(ENOTRECOVERABLE)
+class NamedMutex {
+public:
+    NamedMutex(const char* name);
+    ~NamedMutex();
+
+    void lock();
+    void unlock();
+    bool try_lock();
+
+    // 超时返回false, 使用CLOCK_MONOTONIC
+    template <typename Rep, typename Period>
+    bool try_lock_for(const std::chrono::duration<Rep, Period>& timeout) {
+        return try_lock_until(std::chrono::steady_clock::now() + timeout);
+    }
+
+    template <typename Duration>
+    bool try_lock_until(const std::chrono::time_point<std::chrono::steady_clock, Duration>& deadline) {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+        return timed_lock(ns);
+    }
+
+    // 最近一次加锁时前一个持有者已经崩溃, 只能由持有锁的线程调用
+    bool owner_died() const;
+
+    // 受保护的数据已经修复, 只能由持有锁的线程调用
+    void consistent();
+
+    // 当前持有锁的进程, 没有持有者时为0
+    pid_t owner() const;
+
+    // 不加锁读取, 各字段之间可能不完全一致
+    NamedMutexStats stats();
+
+    // 只能由持有锁的线程调用
+    void reset_stats();
+
+    pthread_mutex_t* native_handle();
+
+    static bool remove(const char* name);
+
+private:
+    NamedMutex(const NamedMutex&) = delete;
+    NamedMutex& operator= (const NamedMutex&) = delete;
+
+    struct Impl {
+        InterprocessOnceFlag once_flag;
+        pthread_mutex_t mutex;
+        std::atomic<pid_t> owner;
+        int64_t lock_time_ns;           // 持有者加锁成功的时间
+        NamedMutexStats stats;
+    };
+
+    bool timed_lock(int64_t deadline_ns);
+    void on_locked(int error, int64_t start_ns, bool contended);
+
+private:
+    SharedMemory<Impl> impl_;
+    bool owner_died_ = false;
+};
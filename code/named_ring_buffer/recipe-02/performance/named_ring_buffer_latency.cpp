@@ -0,0 +1,87 @@
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "named_ring_buffer.hpp"
+
+// 两个进程通过NamedRingBuffer传递消息, 子进程发送, 父进程接收,
+// 输出接收速率和单向延迟的百分位数(CLOCK_MONOTONIC在进程间可比较)
+//
+// 用法: named_ring_buffer_latency [消息个数] [发送间隔ns]
+// 发送间隔为0时生产者全速发送, 缓冲区满时覆盖最旧的消息
+
+const size_t kCapacity = 1024;
+
+struct Message {
+    uint64_t index;
+    int64_t send_ns;
+    uint8_t payload[48];
+};
+
+int64_t now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+template <bool LockFree>
+void run(const char* title, const char* name, uint64_t count, int64_t interval_ns) {
+    SharedMemoryObject::remove(name);
+    NamedRingBuffer<Message, kCapacity, LockFree> ring(name);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        NamedRingBuffer<Message, kCapacity, LockFree> producer(name);
+        Message message = {};
+        int64_t next = now_ns();
+        for (uint64_t i = 0; i < count; i++) {
+            if (interval_ns > 0) {
+                while (now_ns() < next) {
+                }
+                next += interval_ns;
+            }
+            message.index = i;
+            message.send_ns = now_ns();
+            producer.put(message);
+        }
+        _exit(0);
+    }
+
+    std::vector<int64_t> latencies;
+    latencies.reserve(count);
+    Message message;
+    int64_t start = 0;
+    do {
+        ring.get(message);
+        if (latencies.empty()) {
+            start = message.send_ns;
+        }
+        latencies.push_back(now_ns() - message.send_ns);
+    } while (message.index != count - 1);
+    int64_t elapsed = now_ns() - start;
+
+    waitpid(pid, nullptr, 0);
+    SharedMemoryObject::remove(name);
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double p) {
+        return latencies[std::min(latencies.size() - 1, (size_t) (latencies.size() * p))];
+    };
+    printf("%-10s received %8zu/%lu (dropped %lu), %10.0f msgs/sec, latency ns: p50 %ld p90 %ld p99 %ld p99.9 %ld max %ld\n",
+            title, latencies.size(), count, count - latencies.size(),
+            latencies.size() * 1e9 / std::max<int64_t>(elapsed, 1),
+            percentile(0.5), percentile(0.9), percentile(0.99), percentile(0.999), latencies.back());
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1000000;
+    int64_t interval_ns = argc > 2 ? strtoll(argv[2], nullptr, 10) : 0;
+
+    run<false>("mutex", "/named_ring_buffer_latency_mutex", count, interval_ns);
+    run<true>("lockfree", "/named_ring_buffer_latency_lockfree", count, interval_ns);
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include "shared_memory.hpp"
+#include "interprocess_once.hpp"
+#include "interprocess_ring_buffer.hpp"
+#include "lockfree_interprocess_ring_buffer.hpp"
+
+#define FMT_HEADER_ONLY
+#include "fmt/format.h"
+
+#define NAMED_RING_BUFFER_MAGIC 0x78231459
+#define NAMED_LOCKFREE_RING_BUFFER_MAGIC 0x7823145a
+
+// LockFree为true时共享内存中使用LockfreeInterprocessRingBuffer, 快速路径上不加锁;
+// 两种布局使用不同的magic, 以不同模式打开同一个名字会在check_ring_buffer_valid中报错
+template <typename T, size_t N, bool LockFree = false>
+class NamedRingBuffer {
+public:
+    using RingBufferType = typename std::conditional<LockFree,
+          LockfreeInterprocessRingBuffer<T, N>, InterprocessRingBuffer<T, N>>::type;
+
+    static constexpr uint32_t kMagic = LockFree ? NAMED_LOCKFREE_RING_BUFFER_MAGIC : NAMED_RING_BUFFER_MAGIC;
+
+    NamedRingBuffer(const char* name): impl_(name) {
+        InterprocessOnceFlag& once_flag = impl_.get().once_flag;
+        RingBufferType* ring_buffer = &impl_.get().ring_buffer;
+        uint32_t* magic = &impl_.get().magic;
+        size_t* type_size = &impl_.get().type_size;
+        size_t* buffer_size = &impl_.get().buffer_size;
+        interprocess_call_once(once_flag, [ring_buffer, magic, type_size, buffer_size]() { 
+                new (ring_buffer) RingBufferType(); 
+                *magic = kMagic;
+                *type_size = sizeof(T);
+                *buffer_size = N;
+                });
+        check_ring_buffer_valid(*magic, *type_size, *buffer_size);
+    }
+
+    void put(const T& value) {
+        RingBufferType& ring_buffer = impl_.get().ring_buffer;
+        ring_buffer.put(value);
+    }
+
+    void get(T& value) {
+        RingBufferType& ring_buffer = impl_.get().ring_buffer;
+        ring_buffer.get(value);
+    }
+
+    bool try_get(T& value) {
+        RingBufferType& ring_buffer = impl_.get().ring_buffer;
+        return ring_buffer.try_get(value);
+    }
+
+private:
+    void check_ring_buffer_valid(uint32_t magic, size_t type_size, size_t buffer_size) {
+        if (magic != kMagic) {
+            throw std::runtime_error(
+                    fmt::format("check_ring_buffer_valid failed, invalid magic: expect [{}], in fact [{}] ", kMagic, magic)
+                    );
+        }
+
+        if (type_size != sizeof(T)) {
+            throw std::runtime_error(
+                    fmt::format("check_ring_buffer_valid failed, invalid type size: expect [{}], in fact [{}] ", sizeof(T), type_size)
+                    );
+        }
+
+        if (buffer_size != N) {
+            throw std::runtime_error(
+                    fmt::format("check_ring_buffer_valid failed, invalid buffer size: expect [{}], in fact [{}] ", N, buffer_size)
+                    );
+        }
+    }
+
+private:
+    struct Impl {
+        InterprocessOnceFlag once_flag;
+        uint32_t magic;
+        size_t type_size;
+        size_t buffer_size; 
+        RingBufferType ring_buffer;
+    };
+
+    SharedMemory<Impl> impl_;
+};
@@ -0,0 +1,132 @@
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "named_ring_buffer.hpp"
+
+// 两个进程通过NamedRingBuffer传递消息, 子进程发送, 父进程接收,
+// 输出接收速率和单向延迟的百分位数(CLOCK_MONOTONIC在进程间可比较)
+//
+// 用法: named_ring_buffer_latency [消息个数] [发送间隔ns]
+// 发送间隔为0时生产者全速发送, 缓冲区满时覆盖最旧的消息.
+// 生产者填充整个消息, 消费者读取整个消息, 对比put/get的复制和零拷贝接口
+
+const size_t kCapacity = 256;
+const size_t kPayloadSize = 4096;
+
+struct Message {
+    uint64_t index;
+    int64_t send_ns;
+    uint8_t payload[kPayloadSize];
+};
+
+void fill(Message& message, uint64_t index) {
+    message.index = index;
+    std::memset(message.payload, (int) index, sizeof(message.payload));
+}
+
+uint64_t checksum(const Message& message) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < sizeof(message.payload); i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, message.payload + i, sizeof(word));
+        sum += word;
+    }
+    return sum;
+}
+
+// 保存消费者的校验和, 避免读取消息的循环被优化掉
+volatile uint64_t g_checksum;
+
+int64_t now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+template <bool LockFree, bool ZeroCopy>
+void run(const char* title, const char* name, uint64_t count, int64_t interval_ns) {
+    SharedMemoryObject::remove(name);
+    NamedRingBuffer<Message, kCapacity, LockFree> ring(name);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        NamedRingBuffer<Message, kCapacity, LockFree> producer(name);
+        Message message = {};
+        int64_t next = now_ns();
+        for (uint64_t i = 0; i < count; i++) {
+            if (interval_ns > 0) {
+                while (now_ns() < next) {
+                }
+                next += interval_ns;
+            }
+            if (ZeroCopy) {
+                Message* slot = producer.reserve_write();
+                slot->send_ns = now_ns();
+                fill(*slot, i);
+                producer.commit_write(slot);
+            } else {
+                message.send_ns = now_ns();
+                fill(message, i);
+                producer.put(message);
+            }
+        }
+        _exit(0);
+    }
+
+    std::vector<int64_t> latencies;
+    latencies.reserve(count);
+    Message message;
+    uint64_t index;
+    uint64_t sum = 0;
+    int64_t start = 0;
+    do {
+        int64_t send_ns;
+        if (ZeroCopy) {
+            const Message* slot = ring.peek_read();
+            index = slot->index;
+            send_ns = slot->send_ns;
+            sum += checksum(*slot);
+            ring.release_read(slot);
+        } else {
+            ring.get(message);
+            index = message.index;
+            send_ns = message.send_ns;
+            sum += checksum(message);
+        }
+        if (latencies.empty()) {
+            start = send_ns;
+        }
+        latencies.push_back(now_ns() - send_ns);
+    } while (index != count - 1);
+    int64_t elapsed = now_ns() - start;
+
+    waitpid(pid, nullptr, 0);
+    SharedMemoryObject::remove(name);
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double p) {
+        return latencies[std::min(latencies.size() - 1, (size_t) (latencies.size() * p))];
+    };
+    g_checksum = sum;
+    printf("%-18s received %8zu/%lu (dropped %lu), %10.0f msgs/sec, latency ns: p50 %ld p90 %ld p99 %ld p99.9 %ld max %ld\n",
+            title, latencies.size(), count, count - latencies.size(),
+            latencies.size() * 1e9 / std::max<int64_t>(elapsed, 1),
+            percentile(0.5), percentile(0.9), percentile(0.99), percentile(0.999), latencies.back());
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1000000;
+    int64_t interval_ns = argc > 2 ? strtoll(argv[2], nullptr, 10) : 0;
+
+    run<false, false>("mutex", "/named_ring_buffer_latency_mutex", count, interval_ns);
+    run<false, true>("mutex zero-copy", "/named_ring_buffer_latency_mutex", count, interval_ns);
+    run<true, false>("lockfree", "/named_ring_buffer_latency_lockfree", count, interval_ns);
+    run<true, true>("lockfree zero-copy", "/named_ring_buffer_latency_lockfree", count, interval_ns);
+}
@@ -0,0 +1,45 @@
+#include <thread>
+#include <chrono>
+#include <iostream>
+#include <unistd.h>
+#include "named_ring_buffer.hpp"
+
+using namespace std::literals;
+
+const size_t kPayloadSize = 16;
+const char* kRingBufferName = "/sample_lockfree_ring_buffer";
+
+struct Frame {
+    uint32_t index;
+    uint8_t  data[kPayloadSize];
+};
+
+// 第三个模板参数为true时使用无锁的共享内存布局
+NamedRingBuffer<Frame, 5, true> frames{kRingBufferName};
+
+void producer() {
+    Frame frame;
+    for (size_t i = 0; i < 20; i++) {
+        frame.index = i;
+        std::fill_n(frame.data, sizeof(frame.data) - 1, 'a' + i);
+        frame.data[sizeof(frame.data) - 1] = '\0';
+        frames.put(frame);
+        std::this_thread::sleep_for(100ms);
+    }
+}
+
+void consumer() {
+    Frame frame;
+    for (size_t i = 0; i < 20; i++) {
+        frames.get(frame);
+        std::cout << "Frame " << frame.index << ": " << frame.data << std::endl;
+    }
+}
+
+int main() {
+    if (fork()) {
+        consumer();
+    } else {
+        producer();
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <chrono>
+#include "interprocess_semaphore.hpp"
+#include "shared_memory.hpp"
+#include "interprocess_once.hpp"
+
+class NamedSemaphore {
+public:
+    NamedSemaphore() noexcept;
+    ~NamedSemaphore();
+
+    NamedSemaphore(NamedSemaphore&& other); 
+    NamedSemaphore& operator= (NamedSemaphore&& other); 
+
+    void post(unsigned int n = 1);
+    void wait();
+    bool try_wait(unsigned int n = 1);
+    int get_value();
+
+    // 超时返回false, 使用CLOCK_MONOTONIC
+    template <typename Rep, typename Period>
+    bool wait_for(const std::chrono::duration<Rep, Period>& timeout) {
+        return impl_.get().semaphore.wait_for(timeout);
+    }
+
+    template <typename Duration>
+    bool wait_until(const std::chrono::time_point<std::chrono::steady_clock, Duration>& deadline) {
+        return impl_.get().semaphore.wait_until(deadline);
+    }
+
+    static bool exists(const char* name) noexcept;
+    static bool remove(const char* name) noexcept;
+
+    static NamedSemaphore create_only(const char* name, unsigned int value);
+    static NamedSemaphore open_or_create(const char* name, unsigned int value);
+    static NamedSemaphore open_only(const char* name);
+
+private:
+    NamedSemaphore(const NamedSemaphore&) = delete;
+    NamedSemaphore& operator= (const NamedSemaphore&) = delete;
+
+    struct Impl {
+        InterprocessOnceFlag once_flag;
+        InterprocessSemaphore semaphore;
+    };
+
+    explicit NamedSemaphore(SharedMemory<Impl>&& impl);
+    NamedSemaphore(SharedMemory<Impl>&& impl, unsigned int value);
+
+private:
+    SharedMemory<Impl> impl_;
+};
@@ -0,0 +1,205 @@
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+#include "named_shared_mutex.hpp"
+#include "interprocess_mutex.hpp"
+
+// 多个读者进程在锁内读取一份共享数据, 一个写者进程周期性地更新, 输出所有读者的读取速率和写者的更新速率.
+// 对比读者加读锁(NamedSharedMutex)和所有进程共用一把InterprocessMutex.
+//
+// 用法: named_shared_mutex_readers [最多读者进程数] [测试时长ms] [更新间隔us, 0为全速]
+
+const char* kSharedMutexName = "/named_shared_mutex_readers_mtx";
+const char* kMutexName = "/named_shared_mutex_readers_lock";
+const char* kDataName = "/named_shared_mutex_readers_data";
+
+struct Data {
+    uint64_t stamp;
+    uint64_t values[127];
+};
+
+struct GlobalLock {
+    InterprocessOnceFlag once_flag;
+    InterprocessMutex mutex;
+};
+
+// 把两种锁包装成同样的读/写接口
+class SharedLocked {
+public:
+    SharedLocked(): mtx_(kSharedMutexName) {}
+
+    template <typename F>
+    void read(F f) {
+        std::shared_lock<NamedSharedMutex> lock(mtx_);
+        f();
+    }
+
+    template <typename F>
+    void write(F f) {
+        std::unique_lock<NamedSharedMutex> lock(mtx_);
+        f();
+    }
+
+private:
+    NamedSharedMutex mtx_;
+};
+
+class ExclusiveLocked {
+public:
+    ExclusiveLocked(): lock_(SharedMemory<GlobalLock>::open_or_create(kMutexName)) {
+        GlobalLock* lock = &lock_.get();
+        interprocess_call_once(lock->once_flag, [lock]() {
+                new (&lock->mutex) InterprocessMutex();
+                });
+    }
+
+    template <typename F>
+    void read(F f) {
+        std::lock_guard<InterprocessMutex> lock(lock_.get().mutex);
+        f();
+    }
+
+    template <typename F>
+    void write(F f) {
+        std::lock_guard<InterprocessMutex> lock(lock_.get().mutex);
+        f();
+    }
+
+private:
+    SharedMemory<GlobalLock> lock_;
+};
+
+struct Result {
+    uint64_t count;
+    uint64_t errors;
+};
+
+template <typename Locked>
+Result read_loop(std::chrono::steady_clock::time_point deadline) {
+    Locked locked;
+    SharedMemory<Data> data = SharedMemory<Data>::open_or_create(kDataName);
+    const Data& d = data.get();
+    Result result = {0, 0};
+    while (std::chrono::steady_clock::now() < deadline) {
+        for (int i = 0; i < 100; i++) {
+            locked.read([&]() {
+                    uint64_t sum = 0;
+                    for (uint64_t value: d.values) {
+                        sum += value;
+                    }
+                    if (sum != d.stamp * 127) {
+                        result.errors++;
+                    }
+                    });
+        }
+        result.count += 100;
+    }
+    return result;
+}
+
+template <typename Locked>
+Result write_loop(std::chrono::steady_clock::time_point deadline, int interval_us) {
+    Locked locked;
+    SharedMemory<Data> data = SharedMemory<Data>::open_or_create(kDataName);
+    Data& d = data.get();
+    Result result = {0, 0};
+    auto next = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() < deadline) {
+        uint64_t stamp = ++result.count;
+        locked.write([&]() {
+                d.stamp = stamp;
+                for (uint64_t& value: d.values) {
+                    value = stamp;
+                }
+                });
+        if (interval_us > 0) {
+            next += std::chrono::microseconds(interval_us);
+            std::this_thread::sleep_until(next);
+        }
+    }
+    return result;
+}
+
+template <typename Locked>
+void run(const char* title, int readers, int duration_ms, int interval_us) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(duration_ms);
+    std::vector<int> pipes;
+    std::vector<pid_t> children;
+    for (int i = 0; i <= readers; i++) {
+        int fds[2];
+        if (pipe(fds) != 0) {
+            perror("pipe");
+            exit(1);
+        }
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(fds[0]);
+            // 最后一个子进程是写者
+            Result result = (i == readers) ? write_loop<Locked>(deadline, interval_us) : read_loop<Locked>(deadline);
+            if (write(fds[1], &result, sizeof(result)) != sizeof(result)) {
+                perror("write");
+            }
+            _exit(0);
+        }
+        close(fds[1]);
+        pipes.push_back(fds[0]);
+        children.push_back(pid);
+    }
+
+    uint64_t reads = 0;
+    uint64_t errors = 0;
+    uint64_t writes = 0;
+    for (size_t i = 0; i < pipes.size(); i++) {
+        Result result = {0, 0};
+        if (read(pipes[i], &result, sizeof(result)) == sizeof(result)) {
+            if ((int) i == readers) {
+                writes = result.count;
+            } else {
+                reads += result.count;
+                errors += result.errors;
+            }
+        }
+        close(pipes[i]);
+    }
+    for (pid_t pid: children) {
+        waitpid(pid, nullptr, 0);
+    }
+
+    double seconds = duration_ms / 1000.0;
+    printf("%-16s readers %2d: %8.2f M reads/s, %8.2f K writes/s, %lu errors\n",
+            title, readers, reads / seconds / 1e6, writes / seconds / 1e3, (unsigned long) errors);
+}
+
+int main(int argc, char* argv[]) {
+    int max_readers = argc > 1 ? atoi(argv[1]) : (int) std::thread::hardware_concurrency();
+    int duration_ms = argc > 2 ? atoi(argv[2]) : 500;
+    int interval_us = argc > 3 ? atoi(argv[3]) : 100;
+    if (max_readers < 1) {
+        max_readers = 1;
+    }
+
+    NamedSharedMutex::remove(kSharedMutexName);
+    SharedMemory<GlobalLock>::remove(kMutexName);
+    SharedMemory<Data>::remove(kDataName);
+    // 先在父进程中创建, 子进程只打开
+    SharedLocked shared_locked;
+    ExclusiveLocked exclusive_locked;
+    SharedMemory<Data> data = SharedMemory<Data>::open_or_create(kDataName);
+
+    for (int readers = 1; readers <= max_readers; readers *= 2) {
+        run<SharedLocked>("NamedSharedMutex", readers, duration_ms, interval_us);
+        run<ExclusiveLocked>("mutex", readers, duration_ms, interval_us);
+    }
+
+    NamedSharedMutex::remove(kSharedMutexName);
+    SharedMemory<GlobalLock>::remove(kMutexName);
+    SharedMemory<Data>::remove(kDataName);
+}
@@ -0,0 +1,89 @@
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+#include "named_shared_mutex.hpp"
+
+using namespace std::literals;
+
+const char* kMutexName = "sample_shared_config_mtx";
+const char* kConfigName = "sample_shared_config";
+const size_t kReaderCount = 3;
+
+// 写者每次更新时所有字段都写成同一个版本号, 读者据此检查读到的是不是完整的一份
+struct Config {
+    uint64_t version;
+    uint64_t values[63];
+    bool done;
+};
+
+void reader(int id) {
+    NamedSharedMutex mtx(kMutexName);
+    SharedMemory<Config> config = SharedMemory<Config>::open_or_create(kConfigName);
+    size_t reads = 0;
+    size_t errors = 0;
+    uint64_t last_version = 0;
+    while (true) {
+        std::shared_lock<NamedSharedMutex> lock(mtx);
+        const Config& cfg = config.get();
+        for (uint64_t value: cfg.values) {
+            if (value != cfg.version) {
+                errors++;
+                break;
+            }
+        }
+        reads++;
+        last_version = cfg.version;
+        if (cfg.done) {
+            break;
+        }
+    }
+    std::cout << "reader " << id << ": " << reads << " reads, last version " << last_version
+        << ", " << errors << " errors" << std::endl;
+}
+
+int main() {
+    NamedSharedMutex::remove(kMutexName);
+    SharedMemory<Config>::remove(kConfigName);
+
+    NamedSharedMutex mtx(kMutexName);
+    SharedMemory<Config> config = SharedMemory<Config>::open_or_create(kConfigName);
+
+    std::vector<pid_t> children;
+    for (size_t i = 0; i < kReaderCount; i++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            reader(i);
+            return 0;
+        }
+        children.push_back(pid);
+    }
+
+    // 读者一直持有读锁时, 写者仍然可以按时更新
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t version = 1; version <= 1000; version++) {
+        {
+            std::unique_lock<NamedSharedMutex> lock(mtx);
+            Config& cfg = config.get();
+            cfg.version = version;
+            for (uint64_t& value: cfg.values) {
+                value = version;
+            }
+            cfg.done = version == 1000;
+        }
+        std::this_thread::sleep_for(1ms);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    std::cout << "writer: 1000 updates in " << elapsed.count() << " ms" << std::endl;
+
+    for (pid_t pid: children) {
+        waitpid(pid, nullptr, 0);
+    }
+    NamedSharedMutex::remove(kMutexName);
+    SharedMemory<Config>::remove(kConfigName);
+}
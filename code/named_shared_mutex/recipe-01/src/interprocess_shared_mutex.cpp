@@ -0,0 +1,137 @@
+#include "interprocess_shared_mutex.hpp"
+#include <unistd.h>
+#include <stdexcept>
+#include "futex.hpp"
+
+namespace {
+
+const uint32_t kReaderOne = 1;
+const uint32_t kReaderMask = (1u << 20) - 1;
+const uint32_t kWriterOne = 1u << 20;
+const uint32_t kWriterMask = ((1u << 11) - 1) << 20;
+const uint32_t kLocked = 1u << 31;
+
+const int kSpinCount = 100;
+
+const bool kSpinEnabled = sysconf(_SC_NPROCESSORS_ONLN) > 1;
+
+}   // namespace
+
+InterprocessSharedMutex::InterprocessSharedMutex() noexcept: state_(0) {
+}
+
+InterprocessSharedMutex::~InterprocessSharedMutex() {
+}
+
+bool InterprocessSharedMutex::try_lock() {
+    uint32_t state = state_.load(std::memory_order_relaxed);
+    while ((state & (kReaderMask | kLocked)) == 0) {
+        if (state_.compare_exchange_weak(state, state | kLocked, std::memory_order_acquire, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// 已经登记为等待的写者, 拿到锁时同时注销
+bool InterprocessSharedMutex::try_lock_waiting() {
+    uint32_t state = state_.load(std::memory_order_relaxed);
+    while ((state & (kReaderMask | kLocked)) == 0) {
+        if (state_.compare_exchange_weak(state, (state - kWriterOne) | kLocked,
+                    std::memory_order_acquire, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void InterprocessSharedMutex::lock() {
+    if (try_lock()) {
+        return;
+    }
+
+    // 登记之后新的读者不能再加读锁
+    if ((state_.fetch_add(kWriterOne, std::memory_order_relaxed) & kWriterMask) == kWriterMask) {
+        state_.fetch_sub(kWriterOne, std::memory_order_relaxed);
+        throw std::overflow_error("InterprocessSharedMutex: too many waiting writers");
+    }
+
+    if (kSpinEnabled) {
+        for (int i = 0; i < kSpinCount; i++) {
+            if (try_lock_waiting()) {
+                return;
+            }
+            cpu_relax();
+        }
+    }
+
+    while (true) {
+        uint32_t seq = writers_.prepare_wait();
+        bool locked = try_lock_waiting();
+        if (!locked) {
+            writers_.wait(seq);
+        }
+        writers_.finish_wait();
+        if (locked) {
+            return;
+        }
+    }
+}
+
+// 还有写者等待时只唤醒写者, 否则唤醒所有读者
+void InterprocessSharedMutex::unlock() {
+    uint32_t state = state_.fetch_and(~kLocked, std::memory_order_release) & ~kLocked;
+    if (state & kWriterMask) {
+        writers_.ring();
+    } else {
+        readers_.ring_all();
+    }
+}
+
+bool InterprocessSharedMutex::try_lock_shared() {
+    uint32_t state = state_.load(std::memory_order_relaxed);
+    while ((state & (kWriterMask | kLocked)) == 0) {
+        if ((state & kReaderMask) == kReaderMask) {
+            throw std::overflow_error("InterprocessSharedMutex: too many readers");
+        }
+        if (state_.compare_exchange_weak(state, state + kReaderOne, std::memory_order_acquire, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void InterprocessSharedMutex::lock_shared() {
+    if (try_lock_shared()) {
+        return;
+    }
+
+    if (kSpinEnabled) {
+        for (int i = 0; i < kSpinCount; i++) {
+            cpu_relax();
+            if (try_lock_shared()) {
+                return;
+            }
+        }
+    }
+
+    while (true) {
+        uint32_t seq = readers_.prepare_wait();
+        bool locked = try_lock_shared();
+        if (!locked) {
+            readers_.wait(seq);
+        }
+        readers_.finish_wait();
+        if (locked) {
+            return;
+        }
+    }
+}
+
+// 最后一个读者解锁并且有写者等待时唤醒一个写者
+void InterprocessSharedMutex::unlock_shared() {
+    uint32_t state = state_.fetch_sub(kReaderOne, std::memory_order_release) - kReaderOne;
+    if ((state & kReaderMask) == 0 && (state & kWriterMask)) {
+        writers_.ring();
+    }
+}
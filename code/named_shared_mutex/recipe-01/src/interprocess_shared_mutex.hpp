@@ -0,0 +1,36 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "interprocess_doorbell.hpp"
+
+// 基于futex的进程间读写锁, 可以放在共享内存中, 不需要销毁.
+// - 一个32位的状态字: 低20位为持有读锁的个数, 之后11位为等待的写者个数, 最高位表示写锁已被持有
+// - 写者优先: 有写者等待时新的读者不能加读锁, 持续的读者不会饿死写者
+// - 没有竞争时加锁/解锁都只有原子操作; 等待时先短暂自旋, 再在futex门铃上休眠,
+//   读者和写者分别等待, 解锁时只唤醒能拿到锁的一方
+// - 不检查持有者, 持有锁的进程崩溃后其他进程会一直等待
+class InterprocessSharedMutex {
+public:
+    InterprocessSharedMutex() noexcept;
+    ~InterprocessSharedMutex();
+
+    void lock();
+    bool try_lock();
+    void unlock();
+
+    void lock_shared();
+    bool try_lock_shared();
+    void unlock_shared();
+
+private:
+    InterprocessSharedMutex(const InterprocessSharedMutex&) = delete;
+    InterprocessSharedMutex& operator= (const InterprocessSharedMutex&) = delete;
+
+    bool try_lock_waiting();
+
+private:
+    std::atomic<uint32_t> state_;
+    InterprocessDoorbell readers_;      // 读者等待写者解锁
+    InterprocessDoorbell writers_;      // 写者等待读者和写者解锁
+};
@@ -0,0 +1,38 @@
+#include "named_shared_mutex.hpp"
+
+NamedSharedMutex::NamedSharedMutex(const char* name): impl_(SharedMemory<Impl>::open_or_create(name)) {
+    InterprocessOnceFlag& once_flag = impl_.get().once_flag;
+    InterprocessSharedMutex* mutex = &impl_.get().mutex;
+    interprocess_call_once(once_flag, [mutex]() { new (mutex) InterprocessSharedMutex(); });
+}
+
+NamedSharedMutex::~NamedSharedMutex() {
+}
+
+void NamedSharedMutex::lock() {
+    impl_.get().mutex.lock();
+}
+
+void NamedSharedMutex::unlock() {
+    impl_.get().mutex.unlock();
+}
+
+bool NamedSharedMutex::try_lock() {
+    return impl_.get().mutex.try_lock();
+}
+
+void NamedSharedMutex::lock_shared() {
+    impl_.get().mutex.lock_shared();
+}
+
+void NamedSharedMutex::unlock_shared() {
+    impl_.get().mutex.unlock_shared();
+}
+
+bool NamedSharedMutex::try_lock_shared() {
+    return impl_.get().mutex.try_lock_shared();
+}
+
+bool NamedSharedMutex::remove(const char* name) {
+    return SharedMemoryObject::remove(name); 
+}
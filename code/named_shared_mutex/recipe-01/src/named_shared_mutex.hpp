@@ -0,0 +1,33 @@
+#pragma once
+
+#include "shared_memory.hpp"
+#include "interprocess_shared_mutex.hpp"
+#include "interprocess_once.hpp"
+
+// 共享内存中的命名读写锁, 可以配合std::unique_lock和std::shared_lock使用
+class NamedSharedMutex {
+public:
+    NamedSharedMutex(const char* name);
+    ~NamedSharedMutex();
+
+    void lock();
+    void unlock();
+    bool try_lock();
+
+    void lock_shared();
+    void unlock_shared();
+    bool try_lock_shared();
+
+    static bool remove(const char* name);
+
+private:
+    NamedSharedMutex(const NamedSharedMutex&) = delete;
+    NamedSharedMutex& operator= (const NamedSharedMutex&) = delete;
+
+    struct Impl {
+        InterprocessOnceFlag once_flag;
+        InterprocessSharedMutex mutex;
+    };
+
+    SharedMemory<Impl> impl_; 
+};
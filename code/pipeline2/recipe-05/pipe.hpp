@@ -0,0 +1,13 @@
+#pragma once
+
+#include <memory>
+#include "limitedsize_queue.hpp"
+
+// Pipe的容量在创建时确定, 使用预先分配的环形数组存储, 数据流过管道时不再分配内存
+template <typename T>
+using Pipe = std::shared_ptr<limitedsize_queue<T, ring_storage<T>>>;
+
+template <typename T>
+Pipe<T> make_pipe(size_t max_size) {
+    return Pipe<T>(new limitedsize_queue<T, ring_storage<T>>(max_size));
+}
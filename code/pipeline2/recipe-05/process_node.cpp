@@ -0,0 +1,10 @@
+#include "process_node.hpp"
+
+ProcessNode::ProcessNode()
+{
+}
+
+ProcessNode::~ProcessNode()
+{
+}
+
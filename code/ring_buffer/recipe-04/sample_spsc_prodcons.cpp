@@ -0,0 +1,50 @@
+#include <thread>
+#include <chrono>
+#include <iostream>
+#include "spsc_ring_buffer.hpp"
+
+using namespace std::literals;
+
+const size_t kPayloadSize = 16;
+
+struct Frame {
+    uint32_t index;
+    uint8_t  data[kPayloadSize];
+};
+
+// 消费者跟不上时覆盖最旧的帧, 与RingBuffer::put的行为一致
+SpscRingBuffer<Frame, 4, true> frames;
+
+void producer() {
+    Frame batch[2];
+    for (size_t i = 0; i < 20; i += 2) {
+        for (size_t j = 0; j < 2; j++) {
+            batch[j].index = i + j;
+            std::fill_n(batch[j].data, sizeof(batch[j].data) - 1, 'a' + i + j);
+            batch[j].data[sizeof(batch[j].data) - 1] = '\0';
+        }
+        frames.put_bulk(batch, 2);
+        std::this_thread::sleep_for(100ms);
+    }
+}
+
+void consumer() {
+    Frame frame;
+    for (size_t i = 0; i < 20; i++) {
+        std::this_thread::sleep_for(200ms);
+        if (!frames.try_get(frame)) {
+            continue;
+        }
+        std::cout << "Frame " << frame.index << ": " << frame.data << std::endl;
+    }
+}
+
+int main() {
+    std::thread thr_produce, thr_consume;
+
+    thr_produce = std::thread(producer);
+    thr_consume = std::thread(consumer);
+
+    thr_produce.join();
+    thr_consume.join();
+}
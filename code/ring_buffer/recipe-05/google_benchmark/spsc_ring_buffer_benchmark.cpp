@@ -0,0 +1,242 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "spsc_ring_buffer.hpp"
+#include "threadsafe_ring_buffer.hpp"
+
+#include "benchmark/benchmark.h"
+
+const size_t kCapacity = 1024;
+const uint64_t kFrameCount = 200000;
+const size_t kBatchSize = 16;
+
+// 64字节的帧, 带有生产者写入时的时间戳
+struct Frame {
+    uint64_t index;
+    int64_t stamp_ns;
+    uint8_t data[48];
+};
+
+int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+Frame make_frame(uint64_t index) {
+    Frame frame;
+    frame.index = index;
+    frame.stamp_ns = now_ns();
+    return frame;
+}
+
+// 统计收到的帧数和从写入到读出的延迟
+class Receiver {
+public:
+    Receiver() {
+        latencies_.reserve(kFrameCount);
+    }
+
+    // 返回是否已经收到最后一帧
+    bool receive(const Frame& frame) {
+        latencies_.push_back(now_ns() - frame.stamp_ns);
+        return frame.index == kFrameCount - 1;
+    }
+
+    void report(benchmark::State& state, uint64_t sent) {
+        received_ += latencies_.size();
+        sent_ += sent;
+        all_.insert(all_.end(), latencies_.begin(), latencies_.end());
+        latencies_.clear();
+        if (state.iterations() == 0 || all_.empty()) {
+            return;
+        }
+        std::sort(all_.begin(), all_.end());
+        state.counters["frames/s"] = benchmark::Counter(received_, benchmark::Counter::kIsRate);
+        state.counters["dropped"] = benchmark::Counter(sent_ - received_, benchmark::Counter::kAvgIterations);
+        state.counters["p50_ns"] = all_[all_.size() / 2];
+        state.counters["p99_ns"] = all_[all_.size() * 99 / 100];
+    }
+
+private:
+    std::vector<int64_t> latencies_;
+    std::vector<int64_t> all_;
+    uint64_t received_ = 0;
+    uint64_t sent_ = 0;
+};
+
+// 互斥量和条件变量保护的RingBuffer, put覆盖最旧的帧
+void BM_threadsafe_ring_buffer(benchmark::State& state) {
+    auto frames = std::make_unique<ThreadsafeRingBuffer<Frame, kCapacity>>();
+    Receiver receiver;
+    for (auto _ : state) {
+        std::thread producer([&frames] {
+            for (uint64_t i = 0; i < kFrameCount; i++) {
+                frames->put(make_frame(i));
+            }
+        });
+        Frame frame;
+        do {
+            frames->get(frame);
+        } while (!receiver.receive(frame));
+        producer.join();
+        state.PauseTiming();
+        receiver.report(state, kFrameCount);
+        state.ResumeTiming();
+    }
+    receiver.report(state, 0);
+}
+
+// 无锁SPSC, 缓冲区满时生产者等待, 不丢帧
+void BM_spsc_ring_buffer(benchmark::State& state) {
+    auto frames = std::make_unique<SpscRingBuffer<Frame, kCapacity>>();
+    Receiver receiver;
+    for (auto _ : state) {
+        std::thread producer([&frames] {
+            for (uint64_t i = 0; i < kFrameCount; i++) {
+                frames->put(make_frame(i));
+            }
+        });
+        Frame frame;
+        do {
+            frames->get(frame);
+        } while (!receiver.receive(frame));
+        producer.join();
+        state.PauseTiming();
+        receiver.report(state, kFrameCount);
+        state.ResumeTiming();
+    }
+    receiver.report(state, 0);
+}
+
+// 无锁SPSC, 覆盖最旧的帧, 与ThreadsafeRingBuffer语义相同
+void BM_spsc_ring_buffer_overwrite(benchmark::State& state) {
+    auto frames = std::make_unique<SpscRingBuffer<Frame, kCapacity, true>>();
+    Receiver receiver;
+    for (auto _ : state) {
+        std::thread producer([&frames] {
+            for (uint64_t i = 0; i < kFrameCount; i++) {
+                frames->put(make_frame(i));
+            }
+        });
+        Frame frame;
+        do {
+            frames->get(frame);
+        } while (!receiver.receive(frame));
+        producer.join();
+        state.PauseTiming();
+        receiver.report(state, kFrameCount);
+        state.ResumeTiming();
+    }
+    receiver.report(state, 0);
+}
+
+// 无锁SPSC, 每kBatchSize帧发布一次
+void BM_spsc_ring_buffer_bulk(benchmark::State& state) {
+    auto frames = std::make_unique<SpscRingBuffer<Frame, kCapacity>>();
+    Receiver receiver;
+    for (auto _ : state) {
+        std::thread producer([&frames] {
+            Frame batch[kBatchSize];
+            for (uint64_t i = 0; i < kFrameCount; i += kBatchSize) {
+                size_t n = std::min<uint64_t>(kBatchSize, kFrameCount - i);
+                for (size_t j = 0; j < n; j++) {
+                    batch[j] = make_frame(i + j);
+                }
+                for (size_t done = 0; done < n; ) {
+                    size_t put = frames->put_bulk(batch + done, n - done);
+                    if (put == 0) {
+                        std::this_thread::yield();
+                    }
+                    done += put;
+                }
+            }
+        });
+        Frame batch[kBatchSize];
+        bool last = false;
+        while (!last) {
+            size_t n = frames->get_bulk(batch, kBatchSize);
+            if (n == 0) {
+                std::this_thread::yield();
+            }
+            for (size_t j = 0; j < n; j++) {
+                last = receiver.receive(batch[j]);
+            }
+        }
+        producer.join();
+        state.PauseTiming();
+        receiver.report(state, kFrameCount);
+        state.ResumeTiming();
+    }
+    receiver.report(state, 0);
+}
+
+// 零拷贝接口, 生产者在槽中构造帧, 消费者在槽中读取帧
+void BM_threadsafe_ring_buffer_zero_copy(benchmark::State& state) {
+    auto frames = std::make_unique<ThreadsafeRingBuffer<Frame, kCapacity>>();
+    Receiver receiver;
+    for (auto _ : state) {
+        std::thread producer([&frames] {
+            for (uint64_t i = 0; i < kFrameCount; i++) {
+                Frame* frame = frames->reserve_write();
+                frame->index = i;
+                frame->stamp_ns = now_ns();
+                frames->commit_write(frame);
+            }
+        });
+        bool last;
+        do {
+            const Frame* frame = frames->peek_read();
+            last = receiver.receive(*frame);
+            frames->release_read(frame);
+        } while (!last);
+        producer.join();
+        state.PauseTiming();
+        receiver.report(state, kFrameCount);
+        state.ResumeTiming();
+    }
+    receiver.report(state, 0);
+}
+
+void BM_spsc_ring_buffer_zero_copy(benchmark::State& state) {
+    auto frames = std::make_unique<SpscRingBuffer<Frame, kCapacity>>();
+    Receiver receiver;
+    for (auto _ : state) {
+        std::thread producer([&frames] {
+            for (uint64_t i = 0; i < kFrameCount; i++) {
+                Frame* frame;
+                while ((frame = frames->reserve_write()) == nullptr) {
+                    std::this_thread::yield();
+                }
+                frame->index = i;
+                frame->stamp_ns = now_ns();
+                frames->commit_write(frame);
+            }
+        });
+        bool last = false;
+        while (!last) {
+            const Frame* frame = frames->peek_read();
+            if (frame == nullptr) {
+                std::this_thread::yield();
+                continue;
+            }
+            last = receiver.receive(*frame);
+            frames->release_read(frame);
+        }
+        producer.join();
+        state.PauseTiming();
+        receiver.report(state, kFrameCount);
+        state.ResumeTiming();
+    }
+    receiver.report(state, 0);
+}
+
+BENCHMARK(BM_threadsafe_ring_buffer)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_spsc_ring_buffer)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_spsc_ring_buffer_overwrite)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_spsc_ring_buffer_bulk)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_threadsafe_ring_buffer_zero_copy)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_spsc_ring_buffer_zero_copy)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
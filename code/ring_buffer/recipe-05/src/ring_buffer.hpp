@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+
+// 除了put/get按值复制之外, 还可以直接在缓冲区的槽中读写(零拷贝):
+//   T* slot = buffer.reserve_write();   // 缓冲区满时先丢弃最旧的数据
+//   ...直接填充*slot...
+//   buffer.commit_write(slot);
+//
+//   const T* slot = buffer.peek_read(); // 缓冲区空时返回nullptr
+//   ...直接处理*slot...
+//   buffer.release_read(slot);
+// 同一时刻最多有一个未提交的写槽和一个未释放的读槽
+template <class T, size_t N>
+class RingBuffer {
+private:
+    T objects[N];
+    size_t read;
+    size_t write;
+    size_t queued;
+
+public:
+    RingBuffer(): read(0), write(0), queued(0) {}
+
+    void put(const T& value) {
+        objects[write] = value;
+        write = (write + 1) % N;
+        queued++;
+        if (queued > N) {
+            queued = N;
+            read = write;
+        }
+    }
+
+    void get(T& value) {
+        if (!queued) {
+            throw std::runtime_error("No data in the ring buffer");
+        }
+        value = objects[read];
+        read = (read + 1) % N;
+        queued--;
+    }
+
+    bool has_data() {
+        return queued != 0;
+    }
+
+    bool full() {
+        return queued == N;
+    }
+
+    // 返回下一个写入位置的槽, 缓冲区满时先丢弃最旧的数据, 保证写槽不会被读到
+    T* reserve_write() {
+        if (queued == N) {
+            read = (read + 1) % N;
+            queued--;
+        }
+        return &objects[write];
+    }
+
+    // 发布reserve_write返回的槽
+    void commit_write(T* slot) {
+        assert(slot == &objects[write] && "commit a slot not reserved");
+        (void) slot;
+        write = (write + 1) % N;
+        queued++;
+    }
+
+    // 返回最旧数据所在的槽, 缓冲区空时返回nullptr
+    const T* peek_read() {
+        return queued ? &objects[read] : nullptr;
+    }
+
+    // 释放peek_read返回的槽
+    void release_read(const T* slot) {
+        if (!queued) {
+            throw std::runtime_error("No data in the ring buffer");
+        }
+        assert(slot == &objects[read] && "release a slot not peeked");
+        (void) slot;
+        read = (read + 1) % N;
+        queued--;
+    }
+};
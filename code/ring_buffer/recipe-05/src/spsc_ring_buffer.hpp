@@ -0,0 +1,201 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+// 单生产者单消费者环形缓冲区, 不使用锁.
+// - head_(写位置)和tail_(读位置)是单调递增的计数, 分别位于独立的缓存行, 下标通过N-1掩码得到
+// - 生产者缓存最近一次读到的tail_, 消费者缓存最近一次读到的head_, 只有缓存值显示满/空时才重新读取对方的原子变量
+// - put_bulk/get_bulk写入/读取多个元素后只发布一次位置
+// - OverwriteOldest为true时与RingBuffer::put一致, 缓冲区满时覆盖最旧的数据,
+//   此时生产者也会推进tail_, 消费者读出数据后用CAS确认数据没有被覆盖, 要求T可以按位复制
+// - reserve_write/commit_write和peek_read/release_read直接在槽中读写, 不复制T;
+//   覆盖模式下槽可能在读取过程中被覆盖, 不支持peek_read
+template <class T, size_t N, bool OverwriteOldest = false>
+class SpscRingBuffer {
+private:
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "N must be a power of 2");
+    static_assert(!OverwriteOldest || std::is_trivially_copyable<T>::value,
+            "overwrite mode requires a trivially copyable T");
+
+    static constexpr size_t kCacheLineSize = 64;
+    static constexpr size_t kMask = N - 1;
+
+    // 生产者使用的数据
+    alignas(kCacheLineSize) std::atomic<size_t> head_;
+    size_t cached_tail_;
+
+    // 消费者使用的数据
+    alignas(kCacheLineSize) std::atomic<size_t> tail_;
+    size_t cached_head_;
+
+    alignas(kCacheLineSize) T objects_[N];
+
+    // 剩余可写的槽数, 只在生产者线程调用
+    size_t free_slots(size_t head) {
+        size_t free = N - (head - cached_tail_);
+        if (free == 0) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            free = N - (head - cached_tail_);
+        }
+        return free;
+    }
+
+    // 可读的元素个数, 只在消费者线程调用
+    size_t available(size_t tail) {
+        size_t count = cached_head_ - tail;
+        // 覆盖模式下tail可能已被生产者推进到缓存的head之后
+        if (count == 0 || count > N) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            count = cached_head_ - tail;
+        }
+        return count;
+    }
+
+    // 覆盖模式下缓冲区满时丢弃最旧的一个元素, 与消费者竞争tail_
+    void drop_oldest(size_t head) {
+        size_t tail = head - N;
+        if (tail_.compare_exchange_strong(tail, tail + 1, std::memory_order_acq_rel)) {
+            cached_tail_ = tail + 1;
+        } else {
+            cached_tail_ = tail;
+        }
+    }
+
+    template <typename Copy>
+    size_t get_impl(size_t max_n, Copy copy) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        while (true) {
+            size_t n = available(tail);
+            if (n > max_n) {
+                n = max_n;
+            }
+            if (n == 0) {
+                return 0;
+            }
+            for (size_t i = 0; i < n; i++) {
+                copy(i, objects_[(tail + i) & kMask]);
+            }
+            if (!OverwriteOldest) {
+                tail_.store(tail + n, std::memory_order_release);
+                return n;
+            }
+            // 读取期间生产者覆盖了这些槽, 丢弃读到的数据从新的tail_重新读取
+            if (tail_.compare_exchange_strong(tail, tail + n, std::memory_order_acq_rel)) {
+                return n;
+            }
+        }
+    }
+
+public:
+    SpscRingBuffer(): head_(0), cached_tail_(0), tail_(0), cached_head_(0) {}
+
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+    static constexpr size_t capacity() {
+        return N;
+    }
+
+    // 缓冲区满时返回false; 覆盖模式下总是成功
+    bool try_put(const T& value) {
+        return put_bulk(&value, 1) == 1;
+    }
+
+    // 非覆盖模式下缓冲区满时自旋等待, 覆盖模式下与RingBuffer::put相同
+    void put(const T& value) {
+        while (!try_put(value)) {
+            std::this_thread::yield();
+        }
+    }
+
+    // 写入最多n个元素, 只发布一次写位置, 返回写入的个数
+    size_t put_bulk(const T* values, size_t n) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t i = 0;
+        for (; i < n; i++) {
+            if (free_slots(head) == 0) {
+                if (!OverwriteOldest) {
+                    break;
+                }
+                // 先发布已写入的元素, 保证tail_不会超过已发布的head_
+                head_.store(head, std::memory_order_release);
+                drop_oldest(head);
+            }
+            objects_[head & kMask] = values[i];
+            head++;
+        }
+        if (i > 0) {
+            head_.store(head, std::memory_order_release);
+        }
+        return i;
+    }
+
+    bool try_get(T& value) {
+        return get_bulk(&value, 1) == 1;
+    }
+
+    // 缓冲区空时自旋等待
+    void get(T& value) {
+        while (!try_get(value)) {
+            std::this_thread::yield();
+        }
+    }
+
+    // 读取最多max_n个元素, 只发布一次读位置, 返回读取的个数
+    size_t get_bulk(T* values, size_t max_n) {
+        if constexpr (OverwriteOldest) {
+            return get_impl(max_n, [values](size_t i, const T& object) {
+                std::memcpy(static_cast<void*>(values + i), &object, sizeof(T));
+            });
+        } else {
+            return get_impl(max_n, [values](size_t i, T& object) {
+                values[i] = std::move(object);
+            });
+        }
+    }
+
+    // 返回下一个可写的槽, 缓冲区满时返回nullptr; 覆盖模式下先丢弃最旧的数据, 总是成功
+    T* reserve_write() {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (free_slots(head) == 0) {
+            if (!OverwriteOldest) {
+                return nullptr;
+            }
+            drop_oldest(head);
+        }
+        return &objects_[head & kMask];
+    }
+
+    // 发布reserve_write返回的槽
+    void commit_write(T* slot) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        assert(slot == &objects_[head & kMask] && "commit a slot not reserved");
+        (void) slot;
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    // 返回最旧数据所在的槽, 缓冲区空时返回nullptr
+    const T* peek_read() {
+        static_assert(!OverwriteOldest, "peek_read is not supported in overwrite mode");
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        return available(tail) ? &objects_[tail & kMask] : nullptr;
+    }
+
+    // 释放peek_read返回的槽, 之后生产者可以重新写入
+    void release_read(const T* slot) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        assert(slot == &objects_[tail & kMask] && "release a slot not peeked");
+        (void) slot;
+        tail_.store(tail + 1, std::memory_order_release);
+    }
+
+    // 只在消费者线程调用时结果准确
+    bool has_data() {
+        return available(tail_.load(std::memory_order_relaxed)) != 0;
+    }
+};
@@ -0,0 +1,98 @@
+#include "semaphore.hpp"
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <climits>
+#include <ctime>
+
+namespace {
+
+const int kSpinCount = 100;
+
+const bool kSpinEnabled = sysconf(_SC_NPROCESSORS_ONLN) > 1;
+
+int futex_wait_private(std::atomic<uint32_t>* addr, uint32_t expected, const struct timespec* timeout = nullptr) {
+    return syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr), FUTEX_WAIT_PRIVATE, expected, timeout, nullptr, 0);
+}
+
+int futex_wake_private(std::atomic<uint32_t>* addr, int count) {
+    return syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+int64_t monotonic_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+}   // namespace
+
+Semaphore::Semaphore(unsigned int value): count_(value), wakeups_(0) {
+}
+
+Semaphore::~Semaphore() {
+}
+
+void Semaphore::post_slow(uint32_t wakeups) {
+    wakeups_.fetch_add(wakeups, std::memory_order_release);
+    futex_wake_private(&wakeups_, wakeups > INT_MAX ? INT_MAX : wakeups);
+}
+
+bool Semaphore::take_wakeup() {
+    uint32_t wakeups = wakeups_.load(std::memory_order_relaxed);
+    while (wakeups > 0) {
+        if (wakeups_.compare_exchange_weak(wakeups, wakeups - 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// deadline_ns为nullptr时一直等待
+bool Semaphore::wait_slow(const int64_t* deadline_ns) {
+    if (kSpinEnabled) {
+        for (int i = 0; i < kSpinCount; i++) {
+            cpu_relax();
+            if (try_wait()) {
+                return true;
+            }
+        }
+    }
+
+    // 登记为等待者, 之后的post会为我们发放一个唤醒
+    if (count_.fetch_sub(1, std::memory_order_acquire) > 0) {
+        return true;
+    }
+
+    while (!take_wakeup()) {
+        if (deadline_ns == nullptr) {
+            futex_wait_private(&wakeups_, 0);
+            continue;
+        }
+
+        int64_t remain = *deadline_ns - monotonic_ns();
+        if (remain > 0) {
+            struct timespec timeout = {static_cast<time_t>(remain / 1000000000), static_cast<long>(remain % 1000000000)};
+            futex_wait_private(&wakeups_, 0, &timeout);
+            continue;
+        }
+
+        // 超时后撤销登记; count_已经不为负数时post已经为我们发放了唤醒, 必须取走
+        int32_t count = count_.load(std::memory_order_relaxed);
+        while (count < 0) {
+            if (count_.compare_exchange_weak(count, count + 1, std::memory_order_relaxed)) {
+                return false;
+            }
+        }
+        deadline_ns = nullptr;
+    }
+    return true;
+}
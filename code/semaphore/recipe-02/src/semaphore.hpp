@@ -0,0 +1,73 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// 基于futex的进程内计数信号量, 使用FUTEX_PRIVATE_FLAG.
+// - count_为可用的计数减去等待者个数, 为负数时表示有等待者
+// - count_>0时wait/try_wait只有一次CAS, 没有等待者时post只有一次原子加
+// - post只按等待者个数发放唤醒(wakeups_), 被唤醒的线程还没运行时再post不会重复进入内核
+// - post(n)/try_wait(n)一次增加/取走n个计数, try_wait(n)要么取走n个, 要么什么都不取
+class Semaphore {
+public:
+    Semaphore(unsigned int value);
+    ~Semaphore();
+
+    void post(unsigned int n = 1) {
+        int32_t count = count_.fetch_add(n, std::memory_order_release);
+        if (count < 0) {
+            post_slow(std::min<uint32_t>(-count, n));
+        }
+    }
+
+    void wait() {
+        if (!try_wait()) {
+            wait_slow(nullptr);
+        }
+    }
+
+    bool try_wait(unsigned int n = 1) {
+        int32_t count = count_.load(std::memory_order_relaxed);
+        while (count >= (int32_t) n) {
+            if (count_.compare_exchange_weak(count, count - n, std::memory_order_acquire, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 超时返回false
+    template <typename Rep, typename Period>
+    bool wait_for(const std::chrono::duration<Rep, Period>& timeout) {
+        return wait_until(std::chrono::steady_clock::now() + timeout);
+    }
+
+    template <typename Duration>
+    bool wait_until(const std::chrono::time_point<std::chrono::steady_clock, Duration>& deadline) {
+        if (try_wait()) {
+            return true;
+        }
+        int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+        return wait_slow(&ns);
+    }
+
+    // 有等待者时为0
+    int get_value() {
+        int32_t count = count_.load(std::memory_order_relaxed);
+        return count > 0 ? count : 0;
+    }
+
+private:
+    Semaphore(const Semaphore&) = delete;
+    Semaphore& operator= (const Semaphore&) = delete;
+
+    void post_slow(uint32_t wakeups);
+    bool wait_slow(const int64_t* deadline_ns);
+    bool take_wakeup();
+
+private:
+    std::atomic<int32_t> count_;
+    std::atomic<uint32_t> wakeups_;     // futex字, 已经发放还没有被取走的唤醒
+};
@@ -0,0 +1 @@
+../../memory_dump/recipe-01/include/dump_functions.hpp
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include <sys/resource.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <system_error>
+#include <vector>
+#include "shared_memory_object.hpp"
+
+// 对比不同MapOptions下共享内存的映射耗时, 第一次写入(包括缺页)和稳定状态的memcpy带宽
+//
+// 用法: shm_map_bandwidth [共享内存大小MB]
+
+const char* kSharedMemName = "/shm_map_bandwidth";
+const int kSteadyPasses = 5;
+
+struct Config {
+    const char* title;
+    MapOptions options;
+    bool huge_pages;    // hugetlbfs
+};
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+long minor_faults() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_minflt;
+}
+
+void run(const Config& config, const std::vector<char>& source) {
+    size_t size = source.size();
+    double gb = size / 1e9;
+    try {
+        SharedMemoryObject shm = config.huge_pages ?
+            SharedMemoryObject::open_or_create_huge_pages(kSharedMemName) :
+            SharedMemoryObject::open_or_create(kSharedMemName);
+        size_t page_size = shm.page_size();
+        size = size / page_size * page_size;
+        shm.truncate(size);
+
+        auto start = std::chrono::steady_clock::now();
+        char* ptr = static_cast<char*>(shm.map(size, config.options));
+        double map_time = seconds_since(start);
+
+        long faults = minor_faults();
+        start = std::chrono::steady_clock::now();
+        memcpy(ptr, source.data(), size);
+        double first_time = seconds_since(start);
+        faults = minor_faults() - faults;
+
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kSteadyPasses; i++) {
+            memcpy(ptr, source.data(), size);
+        }
+        double steady_time = seconds_since(start) / kSteadyPasses;
+
+        printf("%-22s map %8.2f ms, first touch %6.2f GB/s (%7ld faults), map+first %6.2f GB/s, steady %6.2f GB/s\n",
+                config.title, map_time * 1e3, gb / first_time, faults,
+                gb / (map_time + first_time), gb / steady_time);
+        SharedMemoryObject::unmap(ptr, size);
+    } catch (const std::system_error& e) {
+        printf("%-22s skipped: %s\n", config.title, e.what());
+    }
+
+    if (config.huge_pages) {
+        SharedMemoryObject::remove_huge_pages(kSharedMemName);
+    } else {
+        SharedMemoryObject::remove(kSharedMemName);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t size_mb = argc > 1 ? strtoul(argv[1], nullptr, 10) : 256;
+    std::vector<char> source(size_mb << 20, 'x');
+
+    MapOptions populate;
+    populate.populate = true;
+    MapOptions thp;
+    thp.transparent_huge_pages = true;
+    MapOptions thp_populate = thp;
+    thp_populate.populate = true;
+    MapOptions lock;
+    lock.lock = true;
+    MapOptions numa_populate = populate;
+    numa_populate.numa_node = 0;
+
+    Config configs[] = {
+        {"default", MapOptions(), false},
+        {"populate", populate, false},
+        {"thp", thp, false},
+        {"thp+populate", thp_populate, false},
+        {"mlock", lock, false},
+        {"numa node 0+populate", numa_populate, false},
+        {"hugetlbfs", MapOptions(), true},
+        {"hugetlbfs+populate", populate, true},
+    };
+    for (const Config& config: configs) {
+        run(config, source);
+    }
+}
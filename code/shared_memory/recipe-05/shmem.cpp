@@ -0,0 +1,52 @@
+#include <algorithm>
+#include <iostream>
+#include <chrono>
+#include <thread>
+
+#include <unistd.h>
+
+#include "shared_memory.hpp"
+
+const char* kSharedMemPath = "/sample_point";
+const size_t kPayloadSize = 16;
+
+using namespace std::literals;
+
+template <typename T>
+using SharedMem = SharedMemory<T>;
+
+struct Payload {
+  uint32_t index;
+  uint8_t raw[kPayloadSize];
+};
+
+
+void producer() {
+  SharedMem<Payload> writer(SharedMem<Payload>::open_or_create(kSharedMemPath));
+  Payload& pw = writer.get();
+  for (int i = 0; i < 5; i++) {
+    pw.index = i;
+    std::fill_n(pw.raw, sizeof(pw.raw) - 1, 'a' + i);
+    pw.raw[sizeof(pw.raw) - 1] = '\0';
+    std::this_thread::sleep_for(150ms);
+  }
+}
+
+void consumer() {
+  SharedMem<Payload> point_reader(SharedMem<Payload>::open_or_create(kSharedMemPath));
+  Payload& pr = point_reader.get();
+  for (int i = 0; i < 10; i++) {
+    std::cout << "Read data frame " << pr.index << ": " << pr.raw << std::endl;
+    std::this_thread::sleep_for(100ms);
+  }
+  SharedMemory<Payload>::remove(kSharedMemPath);
+}
+
+int main() {
+
+  if (fork()) {
+    consumer();
+  } else {
+    producer();
+  }
+}
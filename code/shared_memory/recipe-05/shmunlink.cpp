@@ -0,0 +1,22 @@
+#include <sstream>
+#include <gflags/gflags.h>
+
+#include "shared_memory_object.hpp"
+
+DEFINE_string(name, "shm_test", "shared memory name");
+
+std::string usage(const char* prog) {
+    std::ostringstream os;
+    os << "\nusage: " << prog << " [--name NAME]\n\n"
+        << "remove shared memory\n";
+    return os.str();
+}
+
+int main(int argc, char* argv[]) {
+    gflags::SetUsageMessage(usage(argv[0]));
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    SharedMemoryObject::remove(FLAGS_name.c_str());
+
+    return 0;
+}
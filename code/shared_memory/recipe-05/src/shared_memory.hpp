@@ -0,0 +1,95 @@
+#pragma once
+
+#include <utility>
+#include "shared_memory_object.hpp"
+
+// 工厂函数的MapOptions原样传给SharedMemoryObject::map;
+// 映射长度按共享内存的页大小向上取整, hugetlbfs中为大页的整数倍
+template <typename T>
+class SharedMemory {
+public:
+    SharedMemory() {
+    }
+
+    ~SharedMemory() {
+        if (ptr_) {
+            SharedMemoryObject::unmap(ptr_, map_length_);
+        }
+    }
+
+    T& get() const {
+        return *ptr_;
+    }
+
+    SharedMemory(SharedMemory&& other) : shm_mem_obj_(std::move(other.shm_mem_obj_)), ptr_(other.ptr_), map_length_(other.map_length_) {
+        other.ptr_ = nullptr;
+    }
+
+    SharedMemory& operator= (SharedMemory&& other) {
+        if (this == &other) {
+            return *this;
+        }
+
+        if (ptr_) {
+            SharedMemoryObject::unmap(ptr_, map_length_);
+        }
+
+        shm_mem_obj_ = std::move(other.shm_mem_obj_);
+        ptr_ = other.ptr_;
+        map_length_ = other.map_length_;
+
+        other.ptr_ = nullptr;
+        return *this;
+    }
+
+    static SharedMemory create_only(const char* name, const MapOptions& options = MapOptions()) {
+        return SharedMemory{SharedMemoryObject::create_only(name), options};
+    }
+
+    static SharedMemory open_or_create(const char* name, const MapOptions& options = MapOptions()) {
+        return SharedMemory{SharedMemoryObject::open_or_create(name), options};
+    }
+
+    static SharedMemory open_read_write(const char* name, const MapOptions& options = MapOptions()) {
+        return SharedMemory{SharedMemoryObject::open_read_write(name), options};
+    }
+
+    static SharedMemory open_read_only(const char* name, const MapOptions& options = MapOptions()) {
+        return SharedMemory{SharedMemoryObject::open_read_only(name), options, true};
+    }
+
+    static SharedMemory open_or_create_huge_pages(const char* name, const MapOptions& options = MapOptions()) {
+        return SharedMemory{SharedMemoryObject::open_or_create_huge_pages(name), options};
+    }
+
+    static bool exists(const char* name) noexcept {
+        return SharedMemoryObject::exists(name);
+    }
+
+    static bool remove(const char* name) noexcept {
+        return SharedMemoryObject::remove(name);
+    }
+
+    static bool remove_huge_pages(const char* name) noexcept {
+        return SharedMemoryObject::remove_huge_pages(name);
+    }
+
+private:
+    SharedMemory(const SharedMemory&) = delete;
+    SharedMemory& operator= (const SharedMemory&) = delete;
+
+    SharedMemory(SharedMemoryObject&& shm_mem_obj, const MapOptions& options, bool readonly = false):
+        shm_mem_obj_(std::move(shm_mem_obj)) {
+        size_t page_size = shm_mem_obj_.page_size();
+        map_length_ = (sizeof(T) + page_size - 1) / page_size * page_size;
+        if (!readonly && shm_mem_obj_.size() < map_length_) {
+            shm_mem_obj_.truncate(map_length_);
+        }
+        ptr_ = static_cast<T*>(shm_mem_obj_.map(map_length_, options, readonly));
+    }
+
+private:
+    SharedMemoryObject shm_mem_obj_;
+    T* ptr_ = nullptr;
+    size_t map_length_ = 0;
+};
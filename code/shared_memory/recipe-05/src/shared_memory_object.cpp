@@ -0,0 +1,231 @@
+#include "shared_memory_object.hpp"
+
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/statfs.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+#include <fcntl.h>           /* For O_* constants */
+#include <unistd.h>
+
+#include <string>
+#include <system_error>
+
+#define FMT_HEADER_ONLY
+#include "fmt/format.h"
+
+using fmt::format;
+
+namespace {
+
+int Shm_open(const char *name, int oflag, mode_t mode) {
+    int fd;
+    if ((fd = shm_open(name, oflag, mode)) == -1) {
+        throw std::system_error(errno, std::system_category(), 
+                format("shm_open error for {}", name));
+    }
+    return fd;
+}
+
+const mode_t FILE_MODE = (S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+
+std::string huge_pages_path(const char* name, const char* mount_point) {
+    std::string path = mount_point;
+    if (name[0] != '/') {
+        path += '/';
+    }
+    return path + name;
+}
+
+void Mbind(void* addr, size_t length, int node) {
+    const size_t kBitsPerWord = 8 * sizeof(unsigned long);
+    unsigned long nodemask[16] = {};
+    if (node < 0 || (size_t) node >= sizeof(nodemask) * 8) {
+        throw std::system_error(EINVAL, std::system_category(), format("invalid numa node {}", node));
+    }
+    nodemask[node / kBitsPerWord] = 1UL << (node % kBitsPerWord);
+    if (syscall(SYS_mbind, addr, length, MPOL_BIND, nodemask, sizeof(nodemask) * 8, 0) == -1) {
+        throw std::system_error(errno, std::system_category(), format("mbind error for node {}", node));
+    }
+}
+
+// 预先建立页表; 内核不支持MADV_POPULATE_*时逐页读取一次
+void prefault(void* addr, size_t length, bool readonly) {
+#ifdef MADV_POPULATE_WRITE
+    if (madvise(addr, length, readonly ? MADV_POPULATE_READ : MADV_POPULATE_WRITE) == 0) {
+        return;
+    }
+#endif
+    const size_t page = sysconf(_SC_PAGESIZE);
+    volatile const char* p = static_cast<const char*>(addr);
+    for (size_t i = 0; i < length; i += page) {
+        (void) p[i];
+    }
+}
+
+}   // namespace
+
+SharedMemoryObject::SharedMemoryObject() noexcept {
+}
+
+SharedMemoryObject::SharedMemoryObject(int fd): fd_(fd) {
+}
+
+SharedMemoryObject::~SharedMemoryObject() {
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+}
+
+SharedMemoryObject::SharedMemoryObject(SharedMemoryObject&& other) {
+    fd_ = other.fd_;
+    other.fd_ = -1;
+}
+
+SharedMemoryObject& SharedMemoryObject::operator= (SharedMemoryObject&& other) {
+    if (&other == this) {
+        return *this;
+    }
+
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+
+    fd_ = other.fd_;
+    other.fd_ = -1;
+    return *this;
+}
+
+void SharedMemoryObject::truncate(size_t length) {
+    if (ftruncate(fd_, length) == -1) {
+        throw std::system_error(errno, std::system_category(), "ftruncate error");
+    }
+}
+
+size_t SharedMemoryObject::size() const {
+    struct stat stat;
+	if (fstat(fd_, &stat) == -1) {
+        throw std::system_error(errno, std::system_category(), "fstat error");
+    }
+    return stat.st_size;
+}
+
+int SharedMemoryObject::fileno() const {
+    return fd_;
+}
+
+void SharedMemoryObject::swap(SharedMemoryObject& other) noexcept {
+    using std::swap;
+    swap(fd_, other.fd_);
+}
+
+void* SharedMemoryObject::map(size_t length, bool readonly, long offset) {
+	void* ptr;
+    int prot = readonly ? (PROT_READ) : (PROT_READ | PROT_WRITE);
+	if ((ptr = mmap(NULL, length, prot, MAP_SHARED, fd_, offset)) == MAP_FAILED) {
+        throw std::system_error(errno, std::system_category(), "mmap error");
+    }
+	return ptr;
+}
+
+// mbind和madvise需要在页面分配之前完成, 此时不能用MAP_POPULATE, 改为设置之后再预取
+void* SharedMemoryObject::map(size_t length, const MapOptions& options, bool readonly, long offset) {
+    bool advise_first = options.transparent_huge_pages || options.numa_node >= 0;
+    int prot = readonly ? (PROT_READ) : (PROT_READ | PROT_WRITE);
+    int flags = MAP_SHARED;
+    if (options.populate && !advise_first) {
+        flags |= MAP_POPULATE;
+    }
+
+    if (options.address) {
+        flags |= MAP_FIXED_NOREPLACE;
+    }
+
+    void* ptr;
+    if ((ptr = mmap(options.address, length, prot, flags, fd_, offset)) == MAP_FAILED) {
+        throw std::system_error(errno, std::system_category(), "mmap error");
+    }
+    // 老的内核不认识MAP_FIXED_NOREPLACE, 把地址当作提示
+    if (options.address && ptr != options.address) {
+        munmap(ptr, length);
+        throw std::system_error(EEXIST, std::system_category(), format("mmap error, address {} is not available", options.address));
+    }
+
+    try {
+        if (options.numa_node >= 0) {
+            Mbind(ptr, length, options.numa_node);
+        }
+        if (options.transparent_huge_pages && madvise(ptr, length, MADV_HUGEPAGE) == -1) {
+            throw std::system_error(errno, std::system_category(), "madvise MADV_HUGEPAGE error");
+        }
+        if (options.populate && advise_first) {
+            prefault(ptr, length, readonly);
+        }
+        if (options.lock && mlock(ptr, length) == -1) {
+            throw std::system_error(errno, std::system_category(), "mlock error");
+        }
+    } catch (...) {
+        munmap(ptr, length);
+        throw;
+    }
+    return ptr;
+}
+
+size_t SharedMemoryObject::page_size() const {
+    struct statfs stat;
+    if (fstatfs(fd_, &stat) == -1) {
+        throw std::system_error(errno, std::system_category(), "fstatfs error");
+    }
+    return stat.f_bsize;
+}
+
+bool SharedMemoryObject::exists(const char* name) noexcept {
+    if (shm_open(name, O_RDONLY, (S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH)) == -1)
+       return false;
+    else
+       return true; 
+}
+
+bool SharedMemoryObject::remove(const char* name) noexcept {
+    if (shm_unlink(name) == -1) {
+        return false;
+    }
+    return true;
+}
+
+void SharedMemoryObject::unmap(void* addr, size_t length) noexcept {
+    munmap(addr, length);
+}
+
+SharedMemoryObject SharedMemoryObject::create_only(const char* name) {
+    int flags = (O_RDWR | O_CREAT | O_EXCL);
+    return SharedMemoryObject(Shm_open(name, flags, FILE_MODE));
+}
+
+SharedMemoryObject SharedMemoryObject::open_or_create(const char* name) {
+    int flags = (O_RDWR | O_CREAT);
+    return SharedMemoryObject(Shm_open(name, flags, FILE_MODE));
+}
+
+SharedMemoryObject SharedMemoryObject::open_read_write(const char* name) {
+    return SharedMemoryObject(Shm_open(name, O_RDWR, 0));
+}
+
+SharedMemoryObject SharedMemoryObject::open_read_only(const char* name) {
+    return SharedMemoryObject(Shm_open(name, O_RDONLY, 0));
+}
+
+SharedMemoryObject SharedMemoryObject::open_or_create_huge_pages(const char* name, const char* mount_point) {
+    std::string path = huge_pages_path(name, mount_point);
+    int fd;
+    if ((fd = open(path.c_str(), O_RDWR | O_CREAT, FILE_MODE)) == -1) {
+        throw std::system_error(errno, std::system_category(), format("open error for {}", path));
+    }
+    return SharedMemoryObject(fd);
+}
+
+bool SharedMemoryObject::remove_huge_pages(const char* name, const char* mount_point) noexcept {
+    return unlink(huge_pages_path(name, mount_point).c_str()) == 0;
+}
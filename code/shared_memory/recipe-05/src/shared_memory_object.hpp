@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stddef.h>
+
+// map的可选项, 默认与普通的mmap相同
+struct MapOptions {
+    bool populate = false;                  // 映射时预先建立页表, 避免第一次访问时逐页缺页
+    bool transparent_huge_pages = false;    // madvise(MADV_HUGEPAGE), 需要shmem_enabled为advise或always
+    bool lock = false;                      // mlock, 页面常驻内存, 受RLIMIT_MEMLOCK限制
+    int numa_node = -1;                     // 大于等于0时把页面绑定到这个NUMA节点(mbind MPOL_BIND)
+    void* address = nullptr;                // 非空时映射到这个地址(MAP_FIXED_NOREPLACE), 地址已被占用时失败
+};
+
+class SharedMemoryObject {
+public:
+    SharedMemoryObject() noexcept;
+    ~SharedMemoryObject();
+
+    SharedMemoryObject(SharedMemoryObject&& other);
+    SharedMemoryObject& operator= (SharedMemoryObject&& other);
+
+    void truncate(size_t length);
+    size_t size() const;
+    int fileno() const;
+
+    // 映射的长度需要是page_size()的整数倍(hugetlbfs中为大页的大小)
+    size_t page_size() const;
+
+    void* map(size_t length, bool readonly=false, long offset=0);
+    void* map(size_t length, const MapOptions& options, bool readonly=false, long offset=0);
+
+    void swap(SharedMemoryObject& other) noexcept;
+
+    static bool exists(const char* name) noexcept;
+    static bool remove(const char* name) noexcept;
+    static void unmap(void* addr, size_t length) noexcept;
+
+    static SharedMemoryObject create_only(const char* name);
+    static SharedMemoryObject open_or_create(const char* name);
+    static SharedMemoryObject open_read_write(const char* name);
+    static SharedMemoryObject open_read_only(const char* name);
+
+    // 在hugetlbfs中创建/打开共享内存, 页面为大页, 需要预先配置vm.nr_hugepages并挂载hugetlbfs
+    static SharedMemoryObject open_or_create_huge_pages(const char* name, const char* mount_point = "/dev/hugepages");
+    static bool remove_huge_pages(const char* name, const char* mount_point = "/dev/hugepages") noexcept;
+
+private:
+    SharedMemoryObject(const SharedMemoryObject&) = delete;
+    SharedMemoryObject& operator= (const SharedMemoryObject&) = delete;
+
+    explicit SharedMemoryObject(int fd);
+
+private:
+    int fd_ = -1;
+};  
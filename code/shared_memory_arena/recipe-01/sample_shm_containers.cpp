@@ -0,0 +1,105 @@
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <iostream>
+#include "shm_allocator.hpp"
+
+const char* kArenaName = "/sample_shm_arena";
+const size_t kArenaSize = 16 << 20;
+
+using Names = ShmVector<ShmString>;
+using Scores = ShmUnorderedMap<int, double>;
+
+void writer() {
+    ShmArena arena(kArenaName, kArenaSize, true);
+    ShmAllocator<char> alloc(arena);
+
+    Names* names = arena.find_or_construct<Names>("names", alloc);
+    const char* words[] = {"alpha", "beta", "gamma", "a string longer than the small string buffer"};
+    for (const char* word: words) {
+        names->emplace_back(word, alloc);
+    }
+
+    ShmVector<int>* numbers = arena.find_or_construct<ShmVector<int>>("numbers", alloc);
+    for (int i = 0; i < 100000; i++) {
+        numbers->push_back(i);
+    }
+
+    Scores* scores = arena.find_or_construct<Scores>("scores", 16, std::hash<int>(), std::equal_to<int>(), alloc);
+    for (int i = 0; i < 1000; i++) {
+        (*scores)[i] = i * 0.5;
+    }
+
+    std::cout << "writer: base address " << arena.base_address()
+        << ", used " << arena.segment_manager()->used_memory() << " bytes" << std::endl;
+}
+
+void reader() {
+    // same_address模式: 映射到创建者的地址, unordered_map可以直接使用
+    ShmArena arena(kArenaName, kArenaSize, true);
+    Scores* scores = arena.find<Scores>("scores");
+    double sum = 0;
+    for (const auto& kv: *scores) {
+        sum += kv.second;
+    }
+    std::cout << "reader: base address " << arena.base_address()
+        << ", " << scores->size() << " scores, sum " << sum << std::endl;
+
+    // 同一段共享内存再映射一次, 地址不同, vector和string中的OffsetPtr仍然有效
+    ShmArena view(kArenaName, kArenaSize);
+    Names* names = view.find<Names>("names");
+    ShmVector<int>* numbers = view.find<ShmVector<int>>("numbers");
+    long total = 0;
+    for (int n: *numbers) {
+        total += n;
+    }
+    std::cout << "reader: view address " << view.base_address() << ", names:";
+    for (const ShmString& name: *names) {
+        std::cout << " [" << name << "]";
+    }
+    std::cout << ", " << numbers->size() << " numbers, total " << total << std::endl;
+
+    // 通过另一个映射修改, 写者映射中的容器同样可见
+    names->emplace_back("from reader", ShmAllocator<char>(view));
+}
+
+int main() {
+    ShmArena::remove(kArenaName);
+
+    // 先fork再创建共享内存, 子进程中创建者的地址没有被占用
+    int fds[2];
+    if (pipe(fds) != 0) {
+        perror("pipe");
+        return 1;
+    }
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        char c;
+        close(fds[1]);
+        if (read(fds[0], &c, 1) == 1) {
+            reader();
+        }
+        return 0;
+    }
+
+    close(fds[0]);
+    writer();
+    if (write(fds[1], "x", 1) != 1) {
+        perror("write");
+    }
+    close(fds[1]);
+    waitpid(pid, nullptr, 0);
+
+    {
+        ShmArena arena(kArenaName, kArenaSize, true);
+        Names* names = arena.find<Names>("names");
+        std::cout << "writer: names " << names->size() << ", last [" << names->back() << "]" << std::endl;
+
+        arena.destroy<Names>("names");
+        arena.destroy<ShmVector<int>>("numbers");
+        arena.destroy<Scores>("scores");
+        std::cout << "writer: used " << arena.segment_manager()->used_memory() << " bytes after destroy" << std::endl;
+    }
+    ShmArena::remove(kArenaName);
+}
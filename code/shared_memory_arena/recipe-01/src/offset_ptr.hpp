@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+// 保存目标地址相对于指针自身地址的偏移, 共享内存在不同进程中映射到不同地址时仍然有效.
+// 只能指向同一段共享内存中的对象; 复制/赋值时按新位置重新计算偏移.
+// 偏移为1表示空指针(指向自身后一个字节的指针不会出现在实际使用中).
+template <typename T>
+class OffsetPtr {
+public:
+    using element_type = T;
+    using value_type = typename std::remove_cv<T>::type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = typename std::add_lvalue_reference<T>::type;
+    using iterator_category = std::random_access_iterator_tag;
+
+    template <typename U>
+    using rebind = OffsetPtr<U>;
+
+    OffsetPtr() noexcept {}
+
+    OffsetPtr(std::nullptr_t) noexcept {}
+
+    OffsetPtr(T* ptr) noexcept {
+        set(ptr);
+    }
+
+    OffsetPtr(const OffsetPtr& other) noexcept {
+        set(other.get());
+    }
+
+    template <typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    OffsetPtr(const OffsetPtr<U>& other) noexcept {
+        set(other.get());
+    }
+
+    // 与static_cast一致的显式转换, 例如OffsetPtr<void>转为OffsetPtr<T>
+    template <typename U, typename = typename std::enable_if<!std::is_convertible<U*, T*>::value>::type, typename = void>
+    explicit OffsetPtr(const OffsetPtr<U>& other) noexcept {
+        set(static_cast<T*>(other.get()));
+    }
+
+    OffsetPtr& operator= (const OffsetPtr& other) noexcept {
+        set(other.get());
+        return *this;
+    }
+
+    OffsetPtr& operator= (T* ptr) noexcept {
+        set(ptr);
+        return *this;
+    }
+
+    T* get() const noexcept {
+        if (offset_ == kNull) {
+            return nullptr;
+        }
+        return reinterpret_cast<T*>(reinterpret_cast<std::uintptr_t>(this) + offset_);
+    }
+
+    template <typename U = T>
+    typename std::enable_if<!std::is_void<U>::value, U&>::type operator* () const noexcept {
+        return *get();
+    }
+
+    T* operator-> () const noexcept {
+        return get();
+    }
+
+    template <typename U = T>
+    typename std::enable_if<!std::is_void<U>::value, U&>::type operator[] (difference_type n) const noexcept {
+        return get()[n];
+    }
+
+    // libstdc++的std::basic_string要求pointer可以隐式转换为原生指针
+    operator T* () const noexcept {
+        return get();
+    }
+
+    template <typename U = T>
+    static OffsetPtr pointer_to(typename std::enable_if<!std::is_void<U>::value, U&>::type r) noexcept {
+        return OffsetPtr(&r);
+    }
+
+    OffsetPtr& operator++ () noexcept { set(get() + 1); return *this; }
+    OffsetPtr& operator-- () noexcept { set(get() - 1); return *this; }
+    OffsetPtr operator++ (int) noexcept { OffsetPtr old(*this); ++*this; return old; }
+    OffsetPtr operator-- (int) noexcept { OffsetPtr old(*this); --*this; return old; }
+    OffsetPtr& operator+= (difference_type n) noexcept { set(get() + n); return *this; }
+    OffsetPtr& operator-= (difference_type n) noexcept { set(get() - n); return *this; }
+
+    friend OffsetPtr operator+ (const OffsetPtr& p, difference_type n) noexcept { return OffsetPtr(p.get() + n); }
+    friend OffsetPtr operator+ (difference_type n, const OffsetPtr& p) noexcept { return OffsetPtr(p.get() + n); }
+    friend OffsetPtr operator- (const OffsetPtr& p, difference_type n) noexcept { return OffsetPtr(p.get() - n); }
+    friend difference_type operator- (const OffsetPtr& a, const OffsetPtr& b) noexcept { return a.get() - b.get(); }
+
+    friend bool operator== (const OffsetPtr& a, const OffsetPtr& b) noexcept { return a.get() == b.get(); }
+    friend bool operator!= (const OffsetPtr& a, const OffsetPtr& b) noexcept { return a.get() != b.get(); }
+    friend bool operator< (const OffsetPtr& a, const OffsetPtr& b) noexcept { return a.get() < b.get(); }
+    friend bool operator> (const OffsetPtr& a, const OffsetPtr& b) noexcept { return a.get() > b.get(); }
+    friend bool operator<= (const OffsetPtr& a, const OffsetPtr& b) noexcept { return a.get() <= b.get(); }
+    friend bool operator>= (const OffsetPtr& a, const OffsetPtr& b) noexcept { return a.get() >= b.get(); }
+    friend bool operator== (const OffsetPtr& a, std::nullptr_t) noexcept { return !a; }
+    friend bool operator!= (const OffsetPtr& a, std::nullptr_t) noexcept { return static_cast<bool>(a); }
+    friend bool operator== (std::nullptr_t, const OffsetPtr& a) noexcept { return !a; }
+    friend bool operator!= (std::nullptr_t, const OffsetPtr& a) noexcept { return static_cast<bool>(a); }
+
+private:
+    static constexpr std::intptr_t kNull = 1;
+
+    void set(const volatile void* ptr) noexcept {
+        if (ptr == nullptr) {
+            offset_ = kNull;
+        } else {
+            offset_ = reinterpret_cast<std::uintptr_t>(ptr) - reinterpret_cast<std::uintptr_t>(this);
+        }
+    }
+
+private:
+    std::intptr_t offset_ = kNull;
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "shm_arena.hpp"
+
+// 从ShmSegmentManager分配内存的STL分配器, pointer为OffsetPtr<T>.
+// 分配器本身保存的也是OffsetPtr, 放在共享内存里的容器在任何映射地址下都可以使用.
+// 注意: libstdc++的std::vector和std::basic_string使用分配器的pointer类型, 可以放在任意地址映射的共享内存中;
+// std::unordered_map/std::map/std::list等节点容器在节点中保存原生指针,
+// 只能在所有进程都把共享内存映射到同一地址时使用(ShmArena的same_address模式).
+template <typename T>
+class ShmAllocator {
+public:
+    using value_type = T;
+    using pointer = OffsetPtr<T>;
+    using const_pointer = OffsetPtr<const T>;
+    using void_pointer = OffsetPtr<void>;
+    using const_void_pointer = OffsetPtr<const void>;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+
+    template <typename U>
+    struct rebind {
+        using other = ShmAllocator<U>;
+    };
+
+    explicit ShmAllocator(ShmSegmentManager* manager) noexcept: manager_(manager) {}
+
+    ShmAllocator(ShmArena& arena) noexcept: manager_(arena.segment_manager()) {}
+
+    ShmAllocator(const ShmAllocator& other) noexcept: manager_(other.segment_manager()) {}
+
+    template <typename U>
+    ShmAllocator(const ShmAllocator<U>& other) noexcept: manager_(other.segment_manager()) {}
+
+    ShmAllocator& operator= (const ShmAllocator& other) noexcept {
+        manager_ = other.segment_manager();
+        return *this;
+    }
+
+    pointer allocate(size_type n) {
+        static_assert(alignof(T) <= ShmSegmentManager::kAlignment, "over-aligned type is not supported");
+        if (n > size_t(-1) / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        return pointer(static_cast<T*>(manager_->allocate(n * sizeof(T))));
+    }
+
+    void deallocate(pointer p, size_type) {
+        manager_->deallocate(p.get());
+    }
+
+    ShmSegmentManager* segment_manager() const noexcept {
+        return manager_.get();
+    }
+
+private:
+    OffsetPtr<ShmSegmentManager> manager_;
+};
+
+template <typename T, typename U>
+bool operator== (const ShmAllocator<T>& a, const ShmAllocator<U>& b) noexcept {
+    return a.segment_manager() == b.segment_manager();
+}
+
+template <typename T, typename U>
+bool operator!= (const ShmAllocator<T>& a, const ShmAllocator<U>& b) noexcept {
+    return a.segment_manager() != b.segment_manager();
+}
+
+template <typename T>
+using ShmVector = std::vector<T, ShmAllocator<T>>;
+
+using ShmString = std::basic_string<char, std::char_traits<char>, ShmAllocator<char>>;
+
+// 只能用于same_address模式的ShmArena, 见ShmAllocator的说明
+template <typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+using ShmUnorderedMap = std::unordered_map<Key, T, Hash, KeyEqual, ShmAllocator<std::pair<const Key, T>>>;
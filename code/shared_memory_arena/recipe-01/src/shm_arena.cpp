@@ -0,0 +1,333 @@
+#include "shm_arena.hpp"
+
+#include <string.h>
+#include <system_error>
+
+#define FMT_HEADER_ONLY
+#include "fmt/format.h"
+
+#define SHM_ARENA_MAGIC 0x73686d61
+
+namespace {
+
+const uint32_t kBlockUsed = 0x75736564;
+const uint32_t kBlockFree = 0x66726565;
+const uint32_t kLargeClass = 0xffffffff;
+
+size_t align_up(size_t n, size_t alignment) {
+    return (n + alignment - 1) & ~(alignment - 1);
+}
+
+int log2_floor(size_t n) {
+    return 63 - __builtin_clzll(n);
+}
+
+}   // namespace
+
+// 块头后面紧跟数据; 空闲块的数据部分的前8字节保存链表中下一个块的偏移
+struct ShmSegmentManager::BlockHeader {
+    uint64_t size;          // 数据部分的大小
+    uint32_t size_class;    // 大块为kLargeClass
+    uint32_t magic;         // kBlockUsed或kBlockFree
+
+    void* data() {
+        return this + 1;
+    }
+
+    uint64_t& next_free() {
+        return *static_cast<uint64_t*>(data());
+    }
+};
+
+size_t ShmSegmentManager::class_size(size_t size_class) {
+    if (size_class < 8) {
+        return (size_class + 1) * 16;
+    }
+    size_t base = (size_t) 1 << (7 + (size_class - 8) / 4);
+    return base + base / 4 * ((size_class - 8) % 4 + 1);
+}
+
+size_t ShmSegmentManager::size_class_of(size_t size) {
+    if (size <= 128) {
+        return size == 0 ? 0 : (size + 15) / 16 - 1;
+    }
+    int shift = log2_floor(size - 1);
+    size_t base = (size_t) 1 << shift;
+    return 8 + (shift - 7) * 4 + (size - 1 - base) / (base / 4);
+}
+
+void ShmSegmentManager::init(size_t segment_size, void* base_address) {
+    static_assert(sizeof(BlockHeader) == kAlignment, "block header must keep data aligned");
+
+    magic_ = SHM_ARENA_MAGIC;
+    segment_size_ = segment_size;
+    base_address_ = reinterpret_cast<uint64_t>(base_address);
+    new (&mutex_) InterprocessMutex();
+    top_ = align_up(sizeof(ShmSegmentManager), kAlignment);
+    used_ = 0;
+    for (size_t i = 0; i < kSizeClassCount; i++) {
+        free_lists_[i] = 0;
+    }
+    large_free_list_ = 0;
+    new (&directory_mutex_) InterprocessMutex();
+    for (size_t i = 0; i < kMaxNamedObjects; i++) {
+        directory_[i].name[0] = '\0';
+        new (&directory_[i].object) OffsetPtr<void>();
+        directory_[i].size = 0;
+    }
+}
+
+void* ShmSegmentManager::offset_to_ptr(uint64_t offset) {
+    return reinterpret_cast<char*>(this) + offset;
+}
+
+uint64_t ShmSegmentManager::ptr_to_offset(const void* ptr) const {
+    return static_cast<const char*>(ptr) - reinterpret_cast<const char*>(this);
+}
+
+// 从未使用的部分切出一个块, 调用者持有mutex_
+ShmSegmentManager::BlockHeader* ShmSegmentManager::carve(size_t block_size) {
+    if (top_ + sizeof(BlockHeader) + block_size > segment_size_) {
+        return nullptr;
+    }
+    BlockHeader* block = static_cast<BlockHeader*>(offset_to_ptr(top_));
+    block->size = block_size;
+    top_ += sizeof(BlockHeader) + block_size;
+    return block;
+}
+
+// 首次适配, 剩余部分还能作为大块时拆分出来留在链表中原来的位置, 调用者持有mutex_
+ShmSegmentManager::BlockHeader* ShmSegmentManager::find_large(size_t size) {
+    uint64_t* link = &large_free_list_;
+    while (*link) {
+        BlockHeader* block = static_cast<BlockHeader*>(offset_to_ptr(*link));
+        if (block->size >= size) {
+            if (block->size - size >= sizeof(BlockHeader) + kMaxSmallSize + kAlignment) {
+                BlockHeader* rest = reinterpret_cast<BlockHeader*>(static_cast<char*>(block->data()) + size);
+                rest->size = block->size - size - sizeof(BlockHeader);
+                rest->size_class = kLargeClass;
+                rest->magic = kBlockFree;
+                rest->next_free() = block->next_free();
+                *link = ptr_to_offset(rest);
+                block->size = size;
+            } else {
+                *link = block->next_free();
+            }
+            return block;
+        }
+        link = &block->next_free();
+    }
+    return nullptr;
+}
+
+// 大块空闲链表按地址排序, 释放时与相邻的空闲大块合并, 位于末尾时退回未使用的部分, 调用者持有mutex_
+void ShmSegmentManager::free_large(BlockHeader* block) {
+    uint64_t offset = ptr_to_offset(block);
+    uint64_t* prev_link = nullptr;
+    uint64_t* link = &large_free_list_;
+    BlockHeader* prev = nullptr;
+    while (*link && *link < offset) {
+        prev_link = link;
+        prev = static_cast<BlockHeader*>(offset_to_ptr(*link));
+        link = &prev->next_free();
+    }
+
+    uint64_t next_offset = *link;
+    if (next_offset == offset + sizeof(BlockHeader) + block->size) {
+        BlockHeader* next = static_cast<BlockHeader*>(offset_to_ptr(next_offset));
+        block->size += sizeof(BlockHeader) + next->size;
+        next_offset = next->next_free();
+    }
+
+    if (prev && ptr_to_offset(prev) + sizeof(BlockHeader) + prev->size == offset) {
+        prev->size += sizeof(BlockHeader) + block->size;
+        block = prev;
+        link = prev_link;
+    } else {
+        *link = offset;
+    }
+    block->next_free() = next_offset;
+
+    if (next_offset == 0 && ptr_to_offset(block) + sizeof(BlockHeader) + block->size == top_) {
+        top_ = *link;
+        *link = 0;
+    }
+}
+
+void* ShmSegmentManager::allocate(size_t size) {
+    std::lock_guard<InterprocessMutex> lock(mutex_);
+    BlockHeader* block;
+    if (size <= kMaxSmallSize) {
+        size_t size_class = size_class_of(size);
+        if (free_lists_[size_class]) {
+            block = static_cast<BlockHeader*>(offset_to_ptr(free_lists_[size_class]));
+            free_lists_[size_class] = block->next_free();
+        } else {
+            block = carve(class_size(size_class));
+        }
+        if (block) {
+            block->size_class = size_class;
+        }
+    } else {
+        size = align_up(size, kAlignment);
+        block = find_large(size);
+        if (block == nullptr) {
+            block = carve(size);
+        }
+        if (block) {
+            block->size_class = kLargeClass;
+        }
+    }
+
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+    block->magic = kBlockUsed;
+    used_ += sizeof(BlockHeader) + block->size;
+    return block->data();
+}
+
+void ShmSegmentManager::deallocate(void* ptr) {
+    if (ptr == nullptr) {
+        return;
+    }
+
+    std::lock_guard<InterprocessMutex> lock(mutex_);
+    uint64_t offset = ptr_to_offset(ptr);
+    if (ptr < this || offset < align_up(sizeof(ShmSegmentManager), kAlignment) + sizeof(BlockHeader)
+            || offset >= top_ || offset % kAlignment != 0) {
+        throw std::invalid_argument(fmt::format("ShmSegmentManager::deallocate: {} is not in this segment", ptr));
+    }
+    BlockHeader* block = static_cast<BlockHeader*>(ptr) - 1;
+    if (block->magic != kBlockUsed) {
+        throw std::invalid_argument(fmt::format("ShmSegmentManager::deallocate: {} is not an allocated block", ptr));
+    }
+
+    block->magic = kBlockFree;
+    used_ -= sizeof(BlockHeader) + block->size;
+    if (block->size_class == kLargeClass) {
+        free_large(block);
+    } else {
+        block->next_free() = free_lists_[block->size_class];
+        free_lists_[block->size_class] = ptr_to_offset(block);
+    }
+}
+
+size_t ShmSegmentManager::segment_size() const {
+    return segment_size_;
+}
+
+size_t ShmSegmentManager::used_memory() {
+    std::lock_guard<InterprocessMutex> lock(mutex_);
+    return used_;
+}
+
+size_t ShmSegmentManager::untouched_memory() {
+    std::lock_guard<InterprocessMutex> lock(mutex_);
+    return segment_size_ - top_;
+}
+
+ShmSegmentManager::NamedEntry* ShmSegmentManager::lookup(const char* name, size_t size, bool create) {
+    if (strlen(name) > kMaxNameLength) {
+        throw std::invalid_argument(fmt::format("ShmSegmentManager: object name too long: {}", name));
+    }
+
+    NamedEntry* empty = nullptr;
+    for (size_t i = 0; i < kMaxNamedObjects; i++) {
+        NamedEntry* entry = &directory_[i];
+        if (!entry->object) {
+            if (empty == nullptr) {
+                empty = entry;
+            }
+            continue;
+        }
+        if (strcmp(entry->name, name) == 0) {
+            if (entry->size != size) {
+                throw std::runtime_error(
+                        fmt::format("ShmSegmentManager: object {} size mismatch: expect [{}], in fact [{}] ",
+                            name, size, entry->size)
+                        );
+            }
+            return entry;
+        }
+    }
+
+    if (!create) {
+        return nullptr;
+    }
+    if (empty == nullptr) {
+        throw std::runtime_error(fmt::format("ShmSegmentManager: too many named objects, max {}", kMaxNamedObjects));
+    }
+    return empty;
+}
+
+void ShmSegmentManager::bind(NamedEntry* entry, const char* name, void* object, size_t size) {
+    strcpy(entry->name, name);
+    entry->object = object;
+    entry->size = size;
+}
+
+void ShmSegmentManager::unbind(NamedEntry* entry) {
+    entry->name[0] = '\0';
+    entry->object = nullptr;
+    entry->size = 0;
+}
+
+ShmArena::ShmArena(const char* name, size_t size, bool same_address):
+    shm_obj_(SharedMemoryObject::open_or_create(name)), map_size_(size) {
+    if (map_size_ <= sizeof(ShmSegmentManager)) {
+        throw std::invalid_argument(fmt::format("ShmArena size too small: {}", size));
+    }
+
+    if (shm_obj_.size() < map_size_) {
+        shm_obj_.truncate(map_size_);
+    }
+    map_addr_ = shm_obj_.map(map_size_);
+    manager_ = static_cast<ShmSegmentManager*>(map_addr_);
+
+    try {
+        interprocess_call_once(manager_->once_flag_, [this]() {
+                manager_->init(map_size_, map_addr_);
+                });
+        check_arena_valid(map_size_);
+
+        void* base_address = reinterpret_cast<void*>(manager_->base_address_);
+        if (same_address && base_address != map_addr_) {
+            SharedMemoryObject::unmap(map_addr_, map_size_);
+            map_addr_ = nullptr;
+            MapOptions options;
+            options.address = base_address;
+            map_addr_ = shm_obj_.map(map_size_, options);
+            manager_ = static_cast<ShmSegmentManager*>(map_addr_);
+        }
+    } catch (...) {
+        if (map_addr_) {
+            SharedMemoryObject::unmap(map_addr_, map_size_);
+        }
+        throw;
+    }
+}
+
+ShmArena::~ShmArena() {
+    SharedMemoryObject::unmap(map_addr_, map_size_);
+}
+
+void ShmArena::check_arena_valid(size_t size) {
+    if (manager_->magic_ != SHM_ARENA_MAGIC) {
+        throw std::runtime_error(
+                fmt::format("check_arena_valid failed, invalid magic: expect [{}], in fact [{}] ",
+                    SHM_ARENA_MAGIC, manager_->magic_)
+                );
+    }
+
+    if (manager_->segment_size_ != size) {
+        throw std::runtime_error(
+                fmt::format("check_arena_valid failed, invalid size: expect [{}], in fact [{}] ",
+                    size, manager_->segment_size_)
+                );
+    }
+}
+
+bool ShmArena::remove(const char* name) noexcept {
+    return SharedMemoryObject::remove(name);
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include "offset_ptr.hpp"
+#include "interprocess_once.hpp"
+#include "interprocess_mutex.hpp"
+#include "shared_memory_object.hpp"
+
+// 放在共享内存段开头的分配器, 管理这个段中剩余的空间, 所有状态都在共享内存中, 多个进程可以同时使用.
+// - 不超过64KB的请求按44个大小类(16~128按16递增, 之后每个2的幂分4档)分配, 每个大小类一个空闲链表
+// - 超过64KB的请求在按地址排序的大块空闲链表中首次适配, 剩余部分足够大时拆分, 释放时与相邻的空闲大块合并;
+//   小块不合并, 释放后只能被同一大小类重用
+// - 空闲链表都为空时从段中未使用的部分顺序切分
+// - 每个块前面有16字节的块头, 返回的地址按16字节对齐
+// - 段中保存的都是相对于段开头的偏移, 不依赖映射地址
+class ShmSegmentManager {
+public:
+    static constexpr size_t kAlignment = 16;
+    static constexpr size_t kMaxSmallSize = 64 * 1024;
+    static constexpr size_t kSizeClassCount = 44;
+
+    // 空间不足时抛出std::bad_alloc
+    void* allocate(size_t size);
+
+    // ptr必须是这个段中allocate返回的地址, 否则抛出std::invalid_argument
+    void deallocate(void* ptr);
+
+    // 按名字查找对象, 不存在时用args构造一个; 名字已经存在但对象大小不同时抛出std::runtime_error
+    template <typename T, typename... Args>
+    T* find_or_construct(const char* name, Args&&... args) {
+        static_assert(alignof(T) <= kAlignment, "over-aligned type is not supported");
+        std::lock_guard<InterprocessMutex> lock(directory_mutex_);
+        NamedEntry* entry = lookup(name, sizeof(T));
+        if (entry->object) {
+            return static_cast<T*>(entry->object.get());
+        }
+
+        void* ptr = allocate(sizeof(T));
+        T* object;
+        try {
+            object = new (ptr) T(std::forward<Args>(args)...);
+        } catch (...) {
+            deallocate(ptr);
+            throw;
+        }
+        bind(entry, name, object, sizeof(T));
+        return object;
+    }
+
+    // 不存在时返回nullptr
+    template <typename T>
+    T* find(const char* name) {
+        std::lock_guard<InterprocessMutex> lock(directory_mutex_);
+        NamedEntry* entry = lookup(name, sizeof(T), false);
+        return entry ? static_cast<T*>(entry->object.get()) : nullptr;
+    }
+
+    // 析构并释放对象, 不存在时返回false
+    template <typename T>
+    bool destroy(const char* name) {
+        std::lock_guard<InterprocessMutex> lock(directory_mutex_);
+        NamedEntry* entry = lookup(name, sizeof(T), false);
+        if (entry == nullptr) {
+            return false;
+        }
+        T* object = static_cast<T*>(entry->object.get());
+        unbind(entry);
+        object->~T();
+        deallocate(object);
+        return true;
+    }
+
+    size_t segment_size() const;
+
+    // 已分配的块占用的字节数(含块头), 不含空闲链表中的块
+    size_t used_memory();
+
+    // 段中从未分配过的字节数
+    size_t untouched_memory();
+
+    // 每个大小类的块大小, 最后一类为kMaxSmallSize
+    static size_t class_size(size_t size_class);
+    static size_t size_class_of(size_t size);
+
+private:
+    ShmSegmentManager() = delete;
+    ShmSegmentManager(const ShmSegmentManager&) = delete;
+    ShmSegmentManager& operator= (const ShmSegmentManager&) = delete;
+
+    friend class ShmArena;
+
+    static constexpr size_t kMaxNamedObjects = 64;
+    static constexpr size_t kMaxNameLength = 63;
+
+    struct BlockHeader;
+
+    struct NamedEntry {
+        char name[kMaxNameLength + 1];
+        OffsetPtr<void> object;
+        uint64_t size;
+    };
+
+    void init(size_t segment_size, void* base_address);
+    void* offset_to_ptr(uint64_t offset);
+    uint64_t ptr_to_offset(const void* ptr) const;
+    BlockHeader* carve(size_t block_size);
+    BlockHeader* find_large(size_t size);
+    void free_large(BlockHeader* block);
+
+    // create为false时找不到返回nullptr, 否则返回一个空的表项, 表满时抛出std::runtime_error
+    NamedEntry* lookup(const char* name, size_t size, bool create = true);
+    void bind(NamedEntry* entry, const char* name, void* object, size_t size);
+    void unbind(NamedEntry* entry);
+
+private:
+    InterprocessOnceFlag once_flag_;
+    uint32_t magic_;
+    uint64_t segment_size_;
+    uint64_t base_address_;     // 创建者的映射地址, 用于same_address模式
+    InterprocessMutex mutex_;   // 保护下面的分配状态
+    uint64_t top_;              // 未使用部分的起始偏移
+    uint64_t used_;
+    uint64_t free_lists_[kSizeClassCount];
+    uint64_t large_free_list_;
+    InterprocessMutex directory_mutex_;
+    NamedEntry directory_[kMaxNamedObjects];
+};
+
+// 进程内的句柄: 打开或创建一段共享内存, 在其中初始化ShmSegmentManager.
+// same_address为true时把共享内存映射到创建者使用的地址, 用于std::unordered_map/std::map等
+// 在节点中保存原生指针的容器; 这个地址在当前进程中已被占用时抛出std::system_error.
+// 同名的共享内存已经存在时, size必须与创建时一致.
+class ShmArena {
+public:
+    ShmArena(const char* name, size_t size, bool same_address = false);
+    ~ShmArena();
+
+    ShmSegmentManager* segment_manager() const {
+        return manager_;
+    }
+
+    void* allocate(size_t size) {
+        return manager_->allocate(size);
+    }
+
+    void deallocate(void* ptr) {
+        manager_->deallocate(ptr);
+    }
+
+    template <typename T, typename... Args>
+    T* find_or_construct(const char* name, Args&&... args) {
+        return manager_->find_or_construct<T>(name, std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    T* find(const char* name) {
+        return manager_->find<T>(name);
+    }
+
+    template <typename T>
+    bool destroy(const char* name) {
+        return manager_->destroy<T>(name);
+    }
+
+    void* base_address() const {
+        return map_addr_;
+    }
+
+    size_t size() const {
+        return map_size_;
+    }
+
+    static bool remove(const char* name) noexcept;
+
+private:
+    ShmArena(const ShmArena&) = delete;
+    ShmArena& operator= (const ShmArena&) = delete;
+
+    void check_arena_valid(size_t size);
+
+private:
+    SharedMemoryObject shm_obj_;
+    size_t map_size_ = 0;
+    void* map_addr_ = nullptr;
+    ShmSegmentManager* manager_ = nullptr;
+};
@@ -0,0 +1,180 @@
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "shared_snapshot.hpp"
+#include "interprocess_mutex.hpp"
+
+// 一个写者进程不断发布状态, 多个读者进程不断读取最新的状态,
+// 输出所有读者的读取速率和写者的发布速率.
+// 对比SharedSnapshot和SharedMemory加InterprocessMutex(读写都加锁)的实现.
+//
+// 用法: shared_snapshot_readers [最多读者进程数] [测试时长ms] [发布间隔us, 0为全速]
+
+const char* kSnapshotName = "/shared_snapshot_readers";
+const char* kLockedName = "/shared_snapshot_readers_locked";
+
+struct State {
+    uint64_t stamp;
+    uint64_t data[31];
+};
+
+State make_state(uint64_t stamp) {
+    State state;
+    state.stamp = stamp;
+    for (uint64_t& word: state.data) {
+        word = stamp;
+    }
+    return state;
+}
+
+// 加锁的对照实现
+struct LockedState {
+    InterprocessOnceFlag once_flag;
+    InterprocessMutex mutex;
+    State state;
+};
+
+class LockedSnapshot {
+public:
+    explicit LockedSnapshot(const char* name): impl_(SharedMemory<LockedState>::open_or_create(name)) {
+        LockedState* impl = &impl_.get();
+        interprocess_call_once(impl->once_flag, [impl]() {
+                new (&impl->mutex) InterprocessMutex();
+                });
+    }
+
+    void publish(const State& state) {
+        std::lock_guard<InterprocessMutex> lock(impl_.get().mutex);
+        impl_.get().state = state;
+    }
+
+    void load(State& state) {
+        std::lock_guard<InterprocessMutex> lock(impl_.get().mutex);
+        state = impl_.get().state;
+    }
+
+private:
+    SharedMemory<LockedState> impl_;
+};
+
+struct ReaderResult {
+    uint64_t reads;
+    uint64_t errors;
+};
+
+template <typename Snapshot>
+ReaderResult read_loop(const char* name, std::chrono::steady_clock::time_point deadline) {
+    Snapshot snapshot(name);
+    ReaderResult result = {0, 0};
+    State state;
+    while (std::chrono::steady_clock::now() < deadline) {
+        for (int i = 0; i < 100; i++) {
+            snapshot.load(state);
+            if (state.data[30] != state.stamp) {
+                result.errors++;
+            }
+        }
+        result.reads += 100;
+    }
+    return result;
+}
+
+template <typename Snapshot>
+uint64_t write_loop(const char* name, std::chrono::steady_clock::time_point deadline, int interval_us) {
+    Snapshot snapshot(name);
+    uint64_t stamp = 0;
+    auto next = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() < deadline) {
+        snapshot.publish(make_state(++stamp));
+        if (interval_us > 0) {
+            next += std::chrono::microseconds(interval_us);
+            std::this_thread::sleep_until(next);
+        }
+    }
+    return stamp;
+}
+
+template <typename Snapshot>
+void run(const char* title, const char* name, int readers, int duration_ms, int interval_us) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(duration_ms);
+    std::vector<int> pipes;
+    std::vector<pid_t> children;
+    for (int i = 0; i <= readers; i++) {
+        int fds[2];
+        if (pipe(fds) != 0) {
+            perror("pipe");
+            exit(1);
+        }
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(fds[0]);
+            // 最后一个子进程是写者
+            ReaderResult result = {0, 0};
+            if (i == readers) {
+                result.reads = write_loop<Snapshot>(name, deadline, interval_us);
+            } else {
+                result = read_loop<Snapshot>(name, deadline);
+            }
+            if (write(fds[1], &result, sizeof(result)) != sizeof(result)) {
+                perror("write");
+            }
+            _exit(0);
+        }
+        close(fds[1]);
+        pipes.push_back(fds[0]);
+        children.push_back(pid);
+    }
+
+    uint64_t reads = 0;
+    uint64_t errors = 0;
+    uint64_t publishes = 0;
+    for (size_t i = 0; i < pipes.size(); i++) {
+        ReaderResult result = {0, 0};
+        if (read(pipes[i], &result, sizeof(result)) == sizeof(result)) {
+            if ((int) i == readers) {
+                publishes = result.reads;
+            } else {
+                reads += result.reads;
+                errors += result.errors;
+            }
+        }
+        close(pipes[i]);
+    }
+    for (pid_t pid: children) {
+        waitpid(pid, nullptr, 0);
+    }
+
+    double seconds = duration_ms / 1000.0;
+    printf("%-16s readers %2d: %8.2f M reads/s, %8.2f K publishes/s, %lu errors\n",
+            title, readers, reads / seconds / 1e6, publishes / seconds / 1e3, (unsigned long) errors);
+}
+
+int main(int argc, char* argv[]) {
+    int max_readers = argc > 1 ? atoi(argv[1]) : (int) std::thread::hardware_concurrency();
+    int duration_ms = argc > 2 ? atoi(argv[2]) : 500;
+    int interval_us = argc > 3 ? atoi(argv[3]) : 0;
+    if (max_readers < 1) {
+        max_readers = 1;
+    }
+
+    SharedSnapshot<State>::remove(kSnapshotName);
+    SharedMemory<LockedState>::remove(kLockedName);
+    SharedSnapshot<State> snapshot(kSnapshotName);
+    LockedSnapshot locked(kLockedName);
+
+    for (int readers = 1; readers <= max_readers; readers *= 2) {
+        run<SharedSnapshot<State>>("SharedSnapshot", kSnapshotName, readers, duration_ms, interval_us);
+        run<LockedSnapshot>("mutex", kLockedName, readers, duration_ms, interval_us);
+    }
+
+    SharedSnapshot<State>::remove(kSnapshotName);
+    SharedMemory<LockedState>::remove(kLockedName);
+}
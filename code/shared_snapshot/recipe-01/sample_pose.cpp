@@ -0,0 +1,92 @@
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "shared_snapshot.hpp"
+
+using namespace std::literals;
+
+const char* kSnapshotName = "/sample_pose";
+const size_t kReaderCount = 2;
+
+// 写者每次发布时所有字段由同一个计数器算出, 读者据此检查读到的是不是完整的一份
+struct Pose {
+    uint64_t stamp;
+    double position[3];
+    double orientation[4];
+};
+
+Pose make_pose(uint64_t stamp) {
+    Pose pose;
+    pose.stamp = stamp;
+    for (int i = 0; i < 3; i++) {
+        pose.position[i] = stamp * (i + 1);
+    }
+    for (int i = 0; i < 4; i++) {
+        pose.orientation[i] = stamp * 0.5 * (i + 1);
+    }
+    return pose;
+}
+
+bool check_pose(const Pose& pose) {
+    Pose expect = make_pose(pose.stamp);
+    return std::memcmp(&pose, &expect, sizeof(Pose)) == 0;
+}
+
+void reader(int id) {
+    SharedSnapshot<Pose> snapshot(kSnapshotName);
+    uint64_t version = 0;
+    size_t updates = 0;
+    size_t errors = 0;
+    Pose pose;
+    while (true) {
+        if (!snapshot.load_if_newer(pose, version)) {
+            std::this_thread::sleep_for(100us);
+            continue;
+        }
+        updates++;
+        if (!check_pose(pose)) {
+            errors++;
+        }
+        // stamp为0表示结束
+        if (pose.stamp == 0) {
+            break;
+        }
+    }
+    std::cout << "reader " << id << ": " << updates << " updates, last version " << version
+        << ", " << errors << " errors, " << snapshot.retries() << " retries" << std::endl;
+}
+
+int main() {
+    SharedSnapshot<Pose>::remove(kSnapshotName);
+    SharedSnapshot<Pose> snapshot(kSnapshotName);
+
+    std::vector<pid_t> children;
+    for (size_t i = 0; i < kReaderCount; i++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            reader(i);
+            return 0;
+        }
+        children.push_back(pid);
+    }
+
+    // 以1kHz发布1秒
+    auto next = std::chrono::steady_clock::now();
+    for (uint64_t stamp = 1; stamp <= 1000; stamp++) {
+        snapshot.publish(make_pose(stamp));
+        next += 1ms;
+        std::this_thread::sleep_until(next);
+    }
+    snapshot.publish(make_pose(0));
+    std::cout << "writer: " << snapshot.version() << " versions" << std::endl;
+
+    for (pid_t pid: children) {
+        waitpid(pid, nullptr, 0);
+    }
+    SharedSnapshot<Pose>::remove(kSnapshotName);
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include "shared_memory.hpp"
+#include "interprocess_once.hpp"
+
+#define FMT_HEADER_ONLY
+#include "fmt/format.h"
+
+#define SHARED_SNAPSHOT_MAGIC 0x736e6171
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "atomic<uint64_t> need lock free");
+
+// 共享内存中的"最新状态", 一个写者发布, 任意多个读者读取最新的一份.
+// - 双缓冲: 写者总是写当前没有发布的那个槽, 写完后切换发布的版本号, 写者从不等待读者
+// - 每个槽带一个序号(写入中为奇数), 读者复制前后各检查一次, 复制期间写者连续发布两次才需要重读
+// - 槽中保存写入它的版本号, 与数据一起复制, load返回的版本号总是与数据对应
+// - 读者不加锁, 不写共享内存, 读者个数不影响写者
+// - 同一时刻只能有一个进程publish
+template <typename T>
+class SharedSnapshot {
+public:
+    static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable to live in shared memory");
+
+    explicit SharedSnapshot(const char* name): impl_(SharedMemory<Impl>::open_or_create(name)) {
+        Impl* impl = &impl_.get();
+        interprocess_call_once(impl->once_flag, [impl]() {
+                new (&impl->version) std::atomic<uint64_t>(0);
+                for (int i = 0; i < 2; i++) {
+                    new (&impl->slots[i].seq) std::atomic<uint64_t>(0);
+                    new (&impl->slots[i].version) std::atomic<uint64_t>(0);
+                }
+                impl->magic = SHARED_SNAPSHOT_MAGIC;
+                impl->type_size = sizeof(T);
+                });
+        check_snapshot_valid(impl->magic, impl->type_size);
+    }
+
+    // 发布新的状态, 总是O(1), 不等待读者
+    void publish(const T& value) {
+        Impl& impl = impl_.get();
+        uint64_t version = impl.version.load(std::memory_order_relaxed) + 1;
+        Slot& slot = impl.slots[version & 1];
+        uint64_t seq = slot.seq.load(std::memory_order_relaxed);
+        slot.seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.version.store(version, std::memory_order_relaxed);
+        std::memcpy(static_cast<void*>(&slot.value), &value, sizeof(T));
+        slot.seq.store(seq + 2, std::memory_order_release);
+        impl.version.store(version, std::memory_order_release);
+    }
+
+    // 读取最新的状态, 返回它的版本号, 还没有发布过时返回0, value为全0.
+    // 读取版本号之后写者可能已经又发布了两次, 返回的是槽中与数据一起复制的版本号
+    uint64_t load(T& value) const {
+        Impl& impl = impl_.get();
+        while (true) {
+            uint64_t version = impl.version.load(std::memory_order_acquire);
+            if (read_slot(impl.slots[version & 1], value, version)) {
+                return version;
+            }
+            retries_++;
+        }
+    }
+
+    T load() const {
+        T value;
+        load(value);
+        return value;
+    }
+
+    // 版本号比last_version新时读取并更新last_version, 否则返回false, 不复制数据
+    bool load_if_newer(T& value, uint64_t& last_version) const {
+        if (version() == last_version) {
+            return false;
+        }
+        last_version = load(value);
+        return true;
+    }
+
+    // 已发布的次数
+    uint64_t version() const {
+        return impl_.get().version.load(std::memory_order_acquire);
+    }
+
+    // 这个对象的load因为复制期间写者覆盖了槽而重读的次数
+    uint64_t retries() const {
+        return retries_;
+    }
+
+    static bool remove(const char* name) noexcept {
+        return SharedMemory<Impl>::remove(name);
+    }
+
+private:
+    static constexpr size_t kCacheLineSize = 64;
+
+    struct alignas(kCacheLineSize) Slot {
+        std::atomic<uint64_t> seq;
+        std::atomic<uint64_t> version;
+        T value;
+    };
+
+    struct Impl {
+        InterprocessOnceFlag once_flag;
+        uint32_t magic;
+        size_t type_size;
+        alignas(kCacheLineSize) std::atomic<uint64_t> version;
+        Slot slots[2];
+    };
+
+    static bool read_slot(const Slot& slot, T& value, uint64_t& version) {
+        uint64_t seq = slot.seq.load(std::memory_order_acquire);
+        if (seq & 1) {
+            return false;
+        }
+        version = slot.version.load(std::memory_order_relaxed);
+        std::memcpy(static_cast<void*>(&value), &slot.value, sizeof(T));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return slot.seq.load(std::memory_order_relaxed) == seq;
+    }
+
+    void check_snapshot_valid(uint32_t magic, size_t type_size) {
+        if (magic != SHARED_SNAPSHOT_MAGIC) {
+            throw std::runtime_error(
+                    fmt::format("check_snapshot_valid failed, invalid magic: expect [{}], in fact [{}] ",
+                        SHARED_SNAPSHOT_MAGIC, magic)
+                    );
+        }
+
+        if (type_size != sizeof(T)) {
+            throw std::runtime_error(
+                    fmt::format("check_snapshot_valid failed, invalid type size: expect [{}], in fact [{}] ", sizeof(T), type_size)
+                    );
+        }
+    }
+
+private:
+    SharedMemory<Impl> impl_;
+    mutable uint64_t retries_ = 0;
+};
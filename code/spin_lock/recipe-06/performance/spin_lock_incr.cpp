@@ -0,0 +1,129 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "benchmark/benchmark.h"
+
+// 各个recipe的自旋锁类都叫SpinLock, 分别放到不同的名字空间中比较;
+// 标准库头文件已经在上面包含, 这里展开时不会被重复包含
+namespace recipe01 {
+#include "../../recipe-01/spin_lock.hpp"
+}
+#undef SPIN_LOCK_INC
+namespace recipe02 {
+#include "../../recipe-02/spin_lock.hpp"
+}
+namespace recipe03 {
+#include "../../recipe-03/spin_lock.hpp"
+}
+namespace recipe04 {
+#include "../../recipe-04/spin_lock.hpp"
+}
+namespace recipe05 {
+#include "../../recipe-05/spin_lock.hpp"
+}
+#include "spin_lock.hpp"
+
+#define REPEAT2(x) x x
+#define REPEAT4(x) REPEAT2(x) REPEAT2(x)
+#define REPEAT8(x) REPEAT4(x) REPEAT4(x)
+#define REPEAT16(x) REPEAT8(x) REPEAT8(x)
+#define REPEAT32(x) REPEAT16(x) REPEAT16(x)
+#define REPEAT(x) REPEAT32(x)
+
+// 只自旋和yield, 不休眠
+class SpinYieldLock: public SpinLock {
+public:
+    SpinYieldLock(): SpinLock(kDefaultSpinRounds, false) {}
+};
+
+// 开启统计, 输出每次加锁的平均自旋/休眠次数
+class SpinStatsLock: public SpinLock {
+public:
+    SpinStatsLock() {
+        enable_stats(true);
+    }
+};
+
+template <typename Mutex>
+void report_stats(benchmark::State&, Mutex&) {
+}
+
+void report_stats(benchmark::State& state, SpinStatsLock& m) {
+    SpinLockStats stats = m.stats();
+    if (stats.acquisitions > 0) {
+        state.counters["contended"] = (double) stats.contended / stats.acquisitions;
+        state.counters["spins"] = (double) stats.spins / stats.acquisitions;
+        state.counters["parks"] = (double) stats.parks / stats.acquisitions;
+    }
+}
+
+unsigned long x {0};
+
+// 所有线程竞争同一把锁
+template <typename Mutex>
+void BM_mutex(benchmark::State& state) {
+    static Mutex m;
+    if (state.thread_index() == 0) {
+        x = 0;
+    }
+    for (auto _ : state) {
+        REPEAT(
+            {
+                std::lock_guard<Mutex> g(m);
+                benchmark::DoNotOptimize(++x);
+            }
+        );
+    }
+    state.SetItemsProcessed(32*32*state.iterations());
+    if (state.thread_index() == 0) {
+        report_stats(state, m);
+    }
+}
+
+// 每个线程一把锁, 没有竞争
+template <typename Mutex>
+void BM_mutex0(benchmark::State& state) {
+    unsigned long x {0};
+    Mutex m;
+    for (auto _ : state) {
+        REPEAT(
+            {
+                std::lock_guard<Mutex> g(m);
+                benchmark::DoNotOptimize(++x);
+            }
+        );
+    }
+    state.SetItemsProcessed(32*32*state.iterations());
+}
+
+static const long numcpu = sysconf(_SC_NPROCESSORS_CONF);
+#define ARG \
+    ->ThreadRange(1, numcpu) \
+    ->UseRealTime()
+
+BENCHMARK_TEMPLATE(BM_mutex, std::mutex) ARG;
+BENCHMARK_TEMPLATE(BM_mutex, recipe01::SpinLock) ARG;
+BENCHMARK_TEMPLATE(BM_mutex, recipe02::SpinLock) ARG;
+BENCHMARK_TEMPLATE(BM_mutex, recipe03::SpinLock) ARG;
+BENCHMARK_TEMPLATE(BM_mutex, recipe04::SpinLock) ARG;
+BENCHMARK_TEMPLATE(BM_mutex, recipe05::SpinLock) ARG;
+BENCHMARK_TEMPLATE(BM_mutex, SpinLock) ARG;
+BENCHMARK_TEMPLATE(BM_mutex, SpinYieldLock) ARG;
+BENCHMARK_TEMPLATE(BM_mutex, SpinStatsLock) ARG;
+
+BENCHMARK_TEMPLATE(BM_mutex0, std::mutex) ARG;
+BENCHMARK_TEMPLATE(BM_mutex0, recipe01::SpinLock) ARG;
+BENCHMARK_TEMPLATE(BM_mutex0, recipe02::SpinLock) ARG;
+BENCHMARK_TEMPLATE(BM_mutex0, recipe03::SpinLock) ARG;
+BENCHMARK_TEMPLATE(BM_mutex0, recipe04::SpinLock) ARG;
+BENCHMARK_TEMPLATE(BM_mutex0, recipe05::SpinLock) ARG;
+BENCHMARK_TEMPLATE(BM_mutex0, SpinLock) ARG;
+
+BENCHMARK_MAIN();
@@ -0,0 +1,34 @@
+#include <iostream>       // std::cout
+#include <thread>         // std::thread
+#include <mutex>          // std::lock_guard
+#include "spin_lock.hpp"  // SpinLock
+
+long counter = 0;         // protected by mtx
+SpinLock mtx;             // spin 10 rounds, then park
+
+void attempt_100k_increases () {
+  for (int i=0; i<100000; ++i) {
+      std::lock_guard<SpinLock> lock(mtx);
+      ++counter;
+  }
+}
+
+int main ()
+{
+  mtx.enable_stats(true);
+
+  std::thread threads[4];
+  for (int i=0; i<4; ++i)
+    threads[i] = std::thread(attempt_100k_increases);
+
+  for (auto& th : threads) th.join();
+
+  SpinLockStats stats = mtx.stats();
+  std::cout << counter << " successful increases of the counter.\n"
+      << "acquisitions: " << stats.acquisitions
+      << ", contended: " << stats.contended
+      << ", spins per acquisition: " << (double) stats.spins / stats.acquisitions
+      << ", parks per acquisition: " << (double) stats.parks / stats.acquisitions << '\n';
+
+  return 0;
+}
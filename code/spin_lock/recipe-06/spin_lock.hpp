@@ -0,0 +1,150 @@
+#pragma once
+
+#include <atomic> 
+#include <cstdint>
+#include <thread>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be 32 bits");
+
+// 竞争统计, 开启enable_stats后才计数
+struct SpinLockStats {
+    uint64_t acquisitions = 0;      // 加锁成功的次数
+    uint64_t contended = 0;         // 第一次尝试失败, 进入自旋的次数
+    uint64_t spins = 0;             // 自旋等待的pause次数
+    uint64_t parks = 0;             // 在futex上休眠的次数
+};
+
+// 自适应自旋锁:
+// - test-and-test-and-set: 等待时只读锁的状态, 看到空闲才CAS, 不在缓存行上反复写
+// - 每轮失败后执行pause并指数退避(1, 2, 4, ... kMaxBackoff次pause)
+// - 自旋spin_rounds轮之后, park为true时在futex上休眠, 解锁时只在有休眠者时才进入内核;
+//   park为false时改为每次失败yield
+class SpinLock {
+public:
+    static const int kDefaultSpinRounds = 10;
+    static const int kMaxBackoff = 64;
+
+    explicit SpinLock(int spin_rounds = kDefaultSpinRounds, bool park = true):
+        state_{kUnlocked}, spin_rounds_(spin_rounds), park_(park) {}
+
+    void lock() {
+        uint32_t expected = kUnlocked;
+        if (!state_.compare_exchange_strong(expected, kLocked, std::memory_order_acquire, std::memory_order_relaxed)) {
+            lock_slow();
+        }
+        if (stats_enabled_) {
+            acquisitions_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void unlock() {
+        if (!park_) {
+            state_.store(kUnlocked, std::memory_order_release);
+        } else if (state_.exchange(kUnlocked, std::memory_order_release) == kParked) {
+            futex(FUTEX_WAKE_PRIVATE, 1);
+        }
+    }
+
+    bool try_lock() {
+        uint32_t expected = kUnlocked;
+        return state_.load(std::memory_order_relaxed) == kUnlocked &&
+            state_.compare_exchange_strong(expected, kLocked, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    // 开启后每次加锁多一次原子加; 只能在没有线程使用这个锁时调用
+    void enable_stats(bool enable) {
+        stats_enabled_ = enable;
+    }
+
+    SpinLockStats stats() const {
+        SpinLockStats stats;
+        stats.acquisitions = acquisitions_.load(std::memory_order_relaxed);
+        stats.contended = contended_.load(std::memory_order_relaxed);
+        stats.spins = spins_.load(std::memory_order_relaxed);
+        stats.parks = parks_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void reset_stats() {
+        acquisitions_.store(0, std::memory_order_relaxed);
+        contended_.store(0, std::memory_order_relaxed);
+        spins_.store(0, std::memory_order_relaxed);
+        parks_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    SpinLock(const SpinLock&) = delete;
+    SpinLock& operator= (const SpinLock&) = delete;
+
+    enum State: uint32_t {
+        kUnlocked = 0,
+        kLocked = 1,
+        kParked = 2,        // 已加锁, 并且可能有线程在futex上休眠
+    };
+
+    static void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield" ::: "memory");
+#endif
+    }
+
+    void futex(int op, uint32_t value) {
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&state_), op, value, nullptr, nullptr, 0);
+    }
+
+    // 只在看到锁空闲时才尝试写
+    bool test_and_set() {
+        uint32_t expected = kUnlocked;
+        return state_.load(std::memory_order_relaxed) == kUnlocked &&
+            state_.compare_exchange_weak(expected, kLocked, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void lock_slow() {
+        uint64_t spins = 0;
+        int backoff = 1;
+        bool locked = false;
+        for (int round = 0; round < spin_rounds_ && !locked; round++) {
+            for (int i = 0; i < backoff; i++) {
+                cpu_relax();
+            }
+            spins += backoff;
+            backoff = backoff * 2 < kMaxBackoff ? backoff * 2 : kMaxBackoff;
+            locked = test_and_set();
+        }
+
+        uint64_t parks = 0;
+        if (!locked && park_) {
+            // 休眠的线程醒来后以kParked加锁, 解锁时总会检查是否需要唤醒, 不会漏掉其他休眠者
+            while (state_.exchange(kParked, std::memory_order_acquire) != kUnlocked) {
+                parks++;
+                futex(FUTEX_WAIT_PRIVATE, kParked);
+            }
+        } else if (!locked) {
+            while (!test_and_set()) {
+                std::this_thread::yield();
+            }
+        }
+
+        if (stats_enabled_) {
+            contended_.fetch_add(1, std::memory_order_relaxed);
+            spins_.fetch_add(spins, std::memory_order_relaxed);
+            parks_.fetch_add(parks, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    std::atomic<uint32_t> state_;
+    const int spin_rounds_;
+    const bool park_;
+    bool stats_enabled_ = false;
+    std::atomic<uint64_t> acquisitions_{0};
+    std::atomic<uint64_t> contended_{0};
+    std::atomic<uint64_t> spins_{0};
+    std::atomic<uint64_t> parks_{0};
+};
@@ -0,0 +1,73 @@
+#include <unistd.h>
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+#include "thread_pool.hpp"
+
+#include "benchmark/benchmark.h"
+
+const int kTaskCount = 10000;
+const int kChildCount = 100;
+
+void short_task()
+{
+    unsigned long x = 0;
+    for (int i = 0; i < 100; i++) {
+        benchmark::DoNotOptimize(x += i);
+    }
+}
+
+// 所有任务都由外部线程提交
+void BM_submit_external(benchmark::State& state) {
+    thread_pool pool(state.range(0));
+    std::vector<std::future<void>> futures;
+    futures.reserve(kTaskCount);
+    for (auto _ : state) {
+        for (int i = 0; i < kTaskCount; i++) {
+            futures.push_back(pool.submit(short_task));
+        }
+        for (auto& f : futures) {
+            f.get();
+        }
+        futures.clear();
+    }
+    state.SetItemsProcessed(kTaskCount*state.iterations());
+}
+
+// 外部线程只提交少量根任务, 子任务在worker线程内部提交
+void BM_submit_nested(benchmark::State& state) {
+    thread_pool pool(state.range(0));
+    for (auto _ : state) {
+        std::atomic<int> remaining{kTaskCount};
+        std::promise<void> all_done;
+        auto child = [&remaining, &all_done]() {
+            short_task();
+            if (--remaining == 0) {
+                all_done.set_value();
+            }
+        };
+        auto parent = [&pool, child]() {
+            for (int i = 0; i < kChildCount; i++) {
+                pool.submit(child);
+            }
+        };
+        for (int i = 0; i < kTaskCount/kChildCount; i++) {
+            pool.submit(parent);
+        }
+        all_done.get_future().get();
+    }
+    state.SetItemsProcessed(kTaskCount*state.iterations());
+}
+
+static const long numcpu = sysconf(_SC_NPROCESSORS_CONF);
+#define ARG \
+    ->DenseRange(1, numcpu) \
+    ->UseRealTime()
+
+BENCHMARK(BM_submit_external) ARG;
+BENCHMARK(BM_submit_nested) ARG;
+
+BENCHMARK_MAIN();
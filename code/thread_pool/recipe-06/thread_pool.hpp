@@ -0,0 +1,226 @@
+#pragma once
+
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <future>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <type_traits>
+#include "function_wrapper.hpp"
+#include "threadsafe_queue.hpp"
+#include "work_stealing_queue.hpp"
+
+class join_threads
+{
+    std::vector<std::thread>& threads;
+
+public:
+    explicit join_threads(std::vector<std::thread>& threads_):
+        threads(threads_)
+    {}
+
+    ~join_threads()
+    {
+        for(unsigned long i=0;i<threads.size();++i)
+        {
+            if(threads[i].joinable())
+                threads[i].join();
+        }
+    }
+};
+
+class thread_pool
+{
+    typedef function_wrapper task_type;
+
+    static constexpr unsigned spin_count=64;
+
+    std::atomic_bool done;
+    threadsafe_queue<task_type> pool_work_queue;
+    std::vector<std::unique_ptr<work_stealing_queue> > queues;
+
+    // 空闲worker在sleep_cond上休眠, 只有存在休眠线程时submit才需要加锁通知
+    std::mutex sleep_mutex;
+    std::condition_variable sleep_cond;
+    std::atomic<unsigned> sleeping_count;
+    std::atomic<long> pending_count;
+
+    std::vector<std::thread> threads;
+    join_threads joiner;
+
+    inline static thread_local thread_pool* local_pool=nullptr;
+    inline static thread_local work_stealing_queue* local_work_queue=nullptr;
+    inline static thread_local unsigned my_index=0;
+
+    void worker_thread(unsigned my_index_)
+    {
+        my_index=my_index_;
+        local_pool=this;
+        local_work_queue=queues[my_index].get();
+
+        unsigned spins=0;
+        while(true)
+        {
+            task_type task;
+            if(pop_task(task))
+            {
+                task();
+                spins=0;
+            }
+            else if(done)
+            {
+                break;
+            }
+            else if(++spins<spin_count)
+            {
+                std::this_thread::yield();
+            }
+            else
+            {
+                wait_for_task();
+                spins=0;
+            }
+        }
+
+        local_work_queue=nullptr;
+        local_pool=nullptr;
+    }
+
+    bool pop_task_from_local_queue(task_type& task)
+    {
+        return local_pool==this && local_work_queue->try_pop(task);
+    }
+
+    bool pop_task_from_pool_queue(task_type& task)
+    {
+        return pool_work_queue.try_pop(task);
+    }
+
+    bool pop_task_from_other_thread_queue(task_type& task)
+    {
+        for(unsigned i=0;i<queues.size();++i)
+        {
+            unsigned const index=(my_index+i+1)%queues.size();
+            if(queues[index]->try_steal(task))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool pop_task(task_type& task)
+    {
+        if(pop_task_from_local_queue(task) ||
+           pop_task_from_pool_queue(task) ||
+           pop_task_from_other_thread_queue(task))
+        {
+            --pending_count;
+            return true;
+        }
+        return false;
+    }
+
+    void push_task(task_type task)
+    {
+        if(local_pool==this)
+        {
+            local_work_queue->push(std::move(task));
+        }
+        else
+        {
+            pool_work_queue.push(std::move(task));
+        }
+
+        ++pending_count;
+        if(sleeping_count>0)
+        {
+            std::lock_guard<std::mutex> lk(sleep_mutex);
+            sleep_cond.notify_one();
+        }
+    }
+
+    void wait_for_task()
+    {
+        std::unique_lock<std::mutex> lk(sleep_mutex);
+        ++sleeping_count;
+        sleep_cond.wait(lk,[this]{return done || pending_count>0;});
+        --sleeping_count;
+    }
+
+    void stop()
+    {
+        done = true;
+        std::lock_guard<std::mutex> lk(sleep_mutex);
+        sleep_cond.notify_all();
+    }
+
+public:
+    thread_pool(unsigned const thread_count=std::thread::hardware_concurrency()):
+        done(false),sleeping_count(0),pending_count(0),joiner(threads)
+    {
+        try
+        {
+            for(unsigned i=0;i<thread_count;++i)
+            {
+                queues.push_back(std::unique_ptr<work_stealing_queue>(
+                                     new work_stealing_queue));
+            }
+            for(unsigned i=0;i<thread_count;++i)
+            {
+                threads.push_back(
+                    std::thread(&thread_pool::worker_thread,this,i));
+            }
+        }
+        catch(...)
+        {
+            stop();
+            throw;
+        }
+    }
+
+    ~thread_pool()
+    {
+        stop();
+    }
+
+    template<typename FunctionType>
+    std::future<typename std::invoke_result<FunctionType>::type>
+    submit(FunctionType f)
+    {
+        typedef typename std::invoke_result<FunctionType>::type result_type;
+
+        std::packaged_task<result_type()> task(std::move(f));
+        std::future<result_type> res(task.get_future());
+        push_task(std::move(task));
+        return res;
+    }
+
+    template <typename F, typename... Args>
+    std::future<typename std::invoke_result<F, Args...>::type>
+    submit(F&& f, Args&&... args)
+    {
+        typedef typename std::invoke_result<F, Args...>::type result_type;
+
+        std::packaged_task<result_type()> task(std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+        std::future<result_type> res(task.get_future());
+        push_task(std::move(task));
+        return res;
+    }
+
+    void run_pending_task()
+    {
+        task_type task;
+        if(pop_task(task))
+        {
+            task();
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+};
@@ -0,0 +1,25 @@
+#include "alloc_counter.hpp"
+
+#include <cstdlib>
+#include <new>
+
+std::atomic<unsigned long> alloc_count{0};
+
+void* operator new(std::size_t size)
+{
+    alloc_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+#include <atomic>
+
+// alloc_counter.cpp替换了全局operator new/delete, 统计进程内所有线程的堆分配次数
+extern std::atomic<unsigned long> alloc_count;
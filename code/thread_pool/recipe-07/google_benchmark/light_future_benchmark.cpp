@@ -0,0 +1,78 @@
+#include <functional>
+#include <future>
+#include <optional>
+#include <vector>
+#include "alloc_counter.hpp"
+#include "thread_pool.hpp"
+
+#include "benchmark/benchmark.h"
+
+const int kTaskCount = 10000;
+const int kBatchSize = 100;
+
+int small_task(int value)
+{
+    benchmark::DoNotOptimize(value);
+    return value;
+}
+
+void BM_submit_future(benchmark::State& state) {
+    thread_pool pool(state.range(0));
+    std::vector<std::future<int>> futures;
+    futures.reserve(kBatchSize);
+    unsigned long allocs = 0;
+    for (auto _ : state) {
+        unsigned long before = alloc_count.load();
+        for (int i = 0; i < kTaskCount; i += kBatchSize) {
+            for (int j = 0; j < kBatchSize; j++) {
+                futures.push_back(pool.submit([v = i + j] { return small_task(v); }));
+            }
+            for (auto& f : futures) {
+                f.get();
+            }
+            futures.clear();
+        }
+        allocs += alloc_count.load() - before;
+    }
+    state.SetItemsProcessed(kTaskCount*state.iterations());
+    state.counters["allocs_per_task"] = double(allocs) / (kTaskCount*state.iterations());
+}
+
+// light_future不可移动, 通过成员初始化直接接收submit_light的返回值
+struct LightTask {
+    light_future<int> future;
+
+    LightTask(thread_pool& pool, int v):
+        future(pool.submit_light([v] { return small_task(v); }))
+    {}
+};
+
+void BM_submit_light(benchmark::State& state) {
+    thread_pool pool(state.range(0));
+    std::optional<LightTask> tasks[kBatchSize];
+    unsigned long allocs = 0;
+    for (auto _ : state) {
+        unsigned long before = alloc_count.load();
+        for (int i = 0; i < kTaskCount; i += kBatchSize) {
+            for (int j = 0; j < kBatchSize; j++) {
+                tasks[j].emplace(pool, i + j);
+            }
+            for (auto& t : tasks) {
+                t->future.get();
+                t.reset();
+            }
+        }
+        allocs += alloc_count.load() - before;
+    }
+    state.SetItemsProcessed(kTaskCount*state.iterations());
+    state.counters["allocs_per_task"] = double(allocs) / (kTaskCount*state.iterations());
+}
+
+#define ARG \
+    ->Arg(1)->Arg(4) \
+    ->UseRealTime()
+
+BENCHMARK(BM_submit_future) ARG;
+BENCHMARK(BM_submit_light) ARG;
+
+BENCHMARK_MAIN();
@@ -0,0 +1,49 @@
+#include <functional>
+#include <future>
+#include <vector>
+#include "alloc_counter.hpp"
+#include "thread_pool.hpp"
+
+#include "benchmark/benchmark.h"
+
+const int kTaskCount = 10000;
+
+struct SmallTask {
+    int value;
+    int operator()() { benchmark::DoNotOptimize(value); return value; }
+};
+
+struct LargeTask {
+    char payload[256];
+    int operator()() { benchmark::DoNotOptimize(payload); return payload[0]; }
+};
+
+template <typename Task>
+void BM_submit(benchmark::State& state) {
+    thread_pool pool(state.range(0));
+    std::vector<std::future<int>> futures;
+    futures.reserve(kTaskCount);
+    unsigned long allocs = 0;
+    for (auto _ : state) {
+        unsigned long before = alloc_count.load();
+        for (int i = 0; i < kTaskCount; i++) {
+            futures.push_back(pool.submit(Task{}));
+        }
+        for (auto& f : futures) {
+            f.get();
+        }
+        futures.clear();
+        allocs += alloc_count.load() - before;
+    }
+    state.SetItemsProcessed(kTaskCount*state.iterations());
+    state.counters["allocs_per_task"] = double(allocs) / (kTaskCount*state.iterations());
+}
+
+#define ARG \
+    ->Arg(1)->Arg(4) \
+    ->UseRealTime()
+
+BENCHMARK_TEMPLATE(BM_submit, SmallTask) ARG;
+BENCHMARK_TEMPLATE(BM_submit, LargeTask) ARG;
+
+BENCHMARK_MAIN();
@@ -0,0 +1,78 @@
+#include <unistd.h>
+
+#include <cmath>
+#include <functional>
+#include <future>
+#include <vector>
+#include "thread_pool.hpp"
+
+#include "benchmark/benchmark.h"
+
+const std::size_t kElementCount = 4 * 1024 * 1024;
+
+inline double work(std::size_t i)
+{
+    return std::sqrt(static_cast<double>(i));
+}
+
+// 基准: 每个元素一次submit和一个std::future
+void BM_submit_per_element(benchmark::State& state) {
+    thread_pool pool(state.range(0));
+    const std::size_t n = kElementCount / 64;
+    std::vector<double> out(n);
+    std::vector<std::future<void>> futures;
+    futures.reserve(n);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < n; i++) {
+            futures.push_back(pool.submit([&out, i] { out[i] = work(i); }));
+        }
+        for (auto& f : futures) {
+            f.get();
+        }
+        futures.clear();
+    }
+    state.SetItemsProcessed(n*state.iterations());
+}
+
+void BM_parallel_for(benchmark::State& state) {
+    thread_pool pool(state.range(0));
+    std::vector<double> out(kElementCount);
+    for (auto _ : state) {
+        pool.parallel_for(std::size_t(0), kElementCount, std::size_t(4096),
+            [&out](std::size_t i) { out[i] = work(i); });
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(kElementCount*state.iterations());
+}
+
+void BM_parallel_reduce(benchmark::State& state) {
+    thread_pool pool(state.range(0));
+    for (auto _ : state) {
+        double sum = pool.parallel_reduce(std::size_t(0), kElementCount, std::size_t(4096), 0.0,
+            work, std::plus<double>());
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(kElementCount*state.iterations());
+}
+
+void BM_submit_bulk(benchmark::State& state) {
+    thread_pool pool(state.range(0));
+    std::vector<double> values(kElementCount, 2.0);
+    for (auto _ : state) {
+        pool.submit_bulk(values, [](double& v) { v = std::sqrt(v); });
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(kElementCount*state.iterations());
+}
+
+static const long numcpu = sysconf(_SC_NPROCESSORS_CONF);
+#define ARG \
+    ->DenseRange(1, numcpu) \
+    ->UseRealTime()
+
+BENCHMARK(BM_submit_per_element) ARG;
+BENCHMARK(BM_parallel_for) ARG;
+BENCHMARK(BM_parallel_reduce) ARG;
+BENCHMARK(BM_submit_bulk) ARG;
+
+BENCHMARK_MAIN();
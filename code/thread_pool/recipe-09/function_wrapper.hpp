@@ -0,0 +1,249 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// function_wrapper内联缓冲区的默认大小, 可以在编译时通过-D覆盖
+#ifndef FUNCTION_WRAPPER_BUFFER_SIZE
+#define FUNCTION_WRAPPER_BUFFER_SIZE 48
+#endif
+
+// 固定大小内存块的多线程内存池, 放不进内联缓冲区的callable从这里分配
+template <std::size_t BlockSize>
+class function_block_pool
+{
+    struct MemoryChunk {
+        MemoryChunk* next;
+    };
+
+    enum { EXPANSION_SIZE = 32 };
+
+    std::mutex the_mutex;
+    MemoryChunk* free_list = nullptr;
+
+    function_block_pool() {}
+
+    ~function_block_pool()
+    {
+        while(free_list)
+        {
+            MemoryChunk* next=free_list->next;
+            ::operator delete(free_list);
+            free_list=next;
+        }
+    }
+
+    void expand_the_free_list()
+    {
+        for(int i=0;i<EXPANSION_SIZE;++i)
+        {
+            MemoryChunk* chunk=static_cast<MemoryChunk*>(::operator new(BlockSize));
+            chunk->next=free_list;
+            free_list=chunk;
+        }
+    }
+
+public:
+    static_assert(BlockSize >= sizeof(MemoryChunk), "block size too small");
+
+    static function_block_pool& instance()
+    {
+        static function_block_pool pool;
+        return pool;
+    }
+
+    void* alloc()
+    {
+        std::lock_guard<std::mutex> lk(the_mutex);
+        if(!free_list)
+        {
+            expand_the_free_list();
+        }
+        MemoryChunk* head=free_list;
+        free_list=head->next;
+        return head;
+    }
+
+    void free(void* doomed)
+    {
+        MemoryChunk* head=static_cast<MemoryChunk*>(doomed);
+        std::lock_guard<std::mutex> lk(the_mutex);
+        head->next=free_list;
+        free_list=head;
+    }
+};
+
+// 按2的幂对齐块大小, 超过max_pooled_size的callable直接使用operator new
+struct function_block_allocator
+{
+    static constexpr std::size_t max_pooled_size=4096;
+
+    static constexpr std::size_t block_size(std::size_t size)
+    {
+        std::size_t block=sizeof(void*);
+        while(block<size)
+            block*=2;
+        return block;
+    }
+
+    template<std::size_t Size>
+    static void* alloc()
+    {
+        if constexpr(block_size(Size)<=max_pooled_size)
+            return function_block_pool<block_size(Size)>::instance().alloc();
+        else
+            return ::operator new(Size);
+    }
+
+    template<std::size_t Size>
+    static void free(void* p)
+    {
+        if constexpr(block_size(Size)<=max_pooled_size)
+            function_block_pool<block_size(Size)>::instance().free(p);
+        else
+            ::operator delete(p);
+    }
+};
+
+// 小callable直接构造在对象内部的缓冲区中, 调用/移动/析构通过静态函数表分发,
+// 不需要为每个任务分配impl对象
+template<std::size_t BufferSize>
+class basic_function_wrapper
+{
+    struct ops_type {
+        void (*call)(void*);
+        void (*move)(void* dst, void* src);     // 移动构造到dst并析构src
+        void (*destroy)(void*);
+    };
+
+    template<typename F>
+    struct inline_ops
+    {
+        static void call(void* p) { (*static_cast<F*>(p))(); }
+
+        static void move(void* dst, void* src)
+        {
+            F* f=static_cast<F*>(src);
+            new (dst) F(std::move(*f));
+            f->~F();
+        }
+
+        static void destroy(void* p) { static_cast<F*>(p)->~F(); }
+
+        static constexpr ops_type value{call, move, destroy};
+    };
+
+    template<typename F>
+    struct pooled_ops
+    {
+        static F*& get(void* p) { return *static_cast<F**>(p); }
+
+        static void call(void* p) { (*get(p))(); }
+
+        static void move(void* dst, void* src) { new (dst) F*(get(src)); }
+
+        static void destroy(void* p)
+        {
+            F* f=get(p);
+            f->~F();
+            function_block_allocator::free<sizeof(F)>(f);
+        }
+
+        static constexpr ops_type value{call, move, destroy};
+    };
+
+    template<typename F>
+    static constexpr bool fits_inline=
+        sizeof(F)<=BufferSize &&
+        alignof(std::max_align_t)%alignof(F)==0 &&
+        std::is_nothrow_move_constructible<F>::value;
+
+    alignas(std::max_align_t) unsigned char buffer[BufferSize];
+    const ops_type* ops=nullptr;
+
+    void reset()
+    {
+        if(ops)
+        {
+            ops->destroy(buffer);
+            ops=nullptr;
+        }
+    }
+
+    void move_from(basic_function_wrapper& other)
+    {
+        if(other.ops)
+        {
+            other.ops->move(buffer, other.buffer);
+            ops=other.ops;
+            other.ops=nullptr;
+        }
+    }
+
+public:
+    static_assert(BufferSize>=sizeof(void*), "buffer size too small");
+
+    static constexpr std::size_t buffer_size=BufferSize;
+
+    template<typename F>
+    static constexpr bool is_inline=fits_inline<typename std::decay<F>::type>;
+
+    basic_function_wrapper() {}
+
+    template<typename F,
+             typename=typename std::enable_if<
+                 !std::is_same<typename std::decay<F>::type, basic_function_wrapper>::value>::type>
+    basic_function_wrapper(F&& f)
+    {
+        typedef typename std::decay<F>::type functor_type;
+        if constexpr(fits_inline<functor_type>)
+        {
+            new (buffer) functor_type(std::forward<F>(f));
+            ops=&inline_ops<functor_type>::value;
+        }
+        else
+        {
+            void* mem=function_block_allocator::alloc<sizeof(functor_type)>();
+            try
+            {
+                new (buffer) functor_type*(new (mem) functor_type(std::forward<F>(f)));
+            }
+            catch(...)
+            {
+                function_block_allocator::free<sizeof(functor_type)>(mem);
+                throw;
+            }
+            ops=&pooled_ops<functor_type>::value;
+        }
+    }
+
+    ~basic_function_wrapper() { reset(); }
+
+    void operator()() { ops->call(buffer); }
+
+    explicit operator bool() const { return ops!=nullptr; }
+
+    basic_function_wrapper(basic_function_wrapper&& other)
+    {
+        move_from(other);
+    }
+
+    basic_function_wrapper& operator=(basic_function_wrapper&& other)
+    {
+        if(&other!=this)
+        {
+            reset();
+            move_from(other);
+        }
+        return *this;
+    }
+
+    basic_function_wrapper(const basic_function_wrapper&)=delete;
+    basic_function_wrapper(basic_function_wrapper&)=delete;
+    basic_function_wrapper& operator=(const basic_function_wrapper&)=delete;
+};
+
+typedef basic_function_wrapper<FUNCTION_WRAPPER_BUFFER_SIZE> function_wrapper;
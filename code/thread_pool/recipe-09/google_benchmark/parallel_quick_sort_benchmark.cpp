@@ -0,0 +1,104 @@
+#include <unistd.h>
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "thread_pool.hpp"
+
+#include "benchmark/benchmark.h"
+
+const std::size_t kElementCount = 1024 * 1024;
+const std::ptrdiff_t kSortCutoff = 4096;
+const std::size_t kReduceCutoff = 4096;
+
+std::vector<int> make_input()
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist;
+    std::vector<int> input(kElementCount);
+    for (auto& v : input) {
+        v = dist(gen);
+    }
+    return input;
+}
+
+// 较小的一半作为子任务提交, 较大的一半在当前线程递归, 最后通过task_handle::get()协作等待
+template <typename Iterator>
+void parallel_quick_sort(thread_pool& pool, Iterator first, Iterator last)
+{
+    if (last - first <= kSortCutoff) {
+        std::sort(first, last);
+        return;
+    }
+
+    auto pivot = *(first + (last - first) / 2);
+    Iterator middle1 = std::partition(first, last, [pivot](int v) { return v < pivot; });
+    Iterator middle2 = std::partition(middle1, last, [pivot](int v) { return !(pivot < v); });
+
+    auto lower = pool.submit([&pool, first, middle1] { parallel_quick_sort(pool, first, middle1); });
+    parallel_quick_sort(pool, middle2, last);
+    lower.get();
+}
+
+long tree_reduce(thread_pool& pool, const int* first, const int* last)
+{
+    std::size_t n = last - first;
+    if (n <= kReduceCutoff) {
+        return std::accumulate(first, last, 0L);
+    }
+    const int* middle = first + n / 2;
+    auto left = pool.submit([&pool, first, middle] { return tree_reduce(pool, first, middle); });
+    long right = tree_reduce(pool, middle, last);
+    return left.get() + right;
+}
+
+void BM_std_sort(benchmark::State& state) {
+    const std::vector<int> input = make_input();
+    std::vector<int> data;
+    for (auto _ : state) {
+        state.PauseTiming();
+        data = input;
+        state.ResumeTiming();
+        std::sort(data.begin(), data.end());
+    }
+    state.SetItemsProcessed(kElementCount*state.iterations());
+}
+
+// 整个排序作为一个任务提交, 递归中的所有等待都发生在worker线程上
+void BM_parallel_quick_sort(benchmark::State& state) {
+    thread_pool pool(state.range(0));
+    const std::vector<int> input = make_input();
+    std::vector<int> data;
+    for (auto _ : state) {
+        state.PauseTiming();
+        data = input;
+        state.ResumeTiming();
+        pool.submit([&pool, &data] { parallel_quick_sort(pool, data.begin(), data.end()); }).get();
+    }
+    state.SetItemsProcessed(kElementCount*state.iterations());
+}
+
+void BM_tree_reduce(benchmark::State& state) {
+    thread_pool pool(state.range(0));
+    const std::vector<int> input = make_input();
+    for (auto _ : state) {
+        long sum = pool.submit([&pool, &input] {
+            return tree_reduce(pool, input.data(), input.data() + input.size());
+        }).get();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(kElementCount*state.iterations());
+}
+
+static const long numcpu = sysconf(_SC_NPROCESSORS_CONF);
+#define ARG \
+    ->DenseRange(1, numcpu) \
+    ->UseRealTime()
+
+BENCHMARK(BM_std_sort)->UseRealTime();
+BENCHMARK(BM_parallel_quick_sort) ARG;
+BENCHMARK(BM_tree_reduce) ARG;
+
+BENCHMARK_MAIN();
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+template<typename R>
+class light_promise;
+
+// 结果直接保存在light_future对象内部, light_promise只持有指向它的指针,
+// 因此每个任务不需要像std::future那样分配共享状态.
+// 代价是light_future不可复制也不可移动, 析构时会等待任务完成.
+template<typename R>
+class light_future
+{
+    friend class light_promise<R>;
+
+    typedef typename std::conditional<std::is_void<R>::value, char,
+            typename std::conditional<std::is_reference<R>::value,
+                std::reference_wrapper<typename std::remove_reference<R>::type>,
+                R>::type>::type value_type;
+
+    mutable std::mutex mut;
+    mutable std::condition_variable cond;
+    bool ready=false;
+    std::optional<value_type> value;
+    std::exception_ptr exception;
+
+    template<typename... Args>
+    void set_value(Args&&... args)
+    {
+        std::lock_guard<std::mutex> lk(mut);
+        value.emplace(std::forward<Args>(args)...);
+        ready=true;
+        cond.notify_all();
+    }
+
+    void set_exception(std::exception_ptr e)
+    {
+        std::lock_guard<std::mutex> lk(mut);
+        exception=e;
+        ready=true;
+        cond.notify_all();
+    }
+
+public:
+    // launch接收绑定到当前对象的light_promise, 负责把任务投递出去
+    template<typename Launch>
+    explicit light_future(Launch&& launch)
+    {
+        launch(light_promise<R>(this));
+    }
+
+    ~light_future()
+    {
+        wait();
+    }
+
+    light_future(const light_future&)=delete;
+    light_future& operator=(const light_future&)=delete;
+
+    bool is_ready() const
+    {
+        std::lock_guard<std::mutex> lk(mut);
+        return ready;
+    }
+
+    void wait() const
+    {
+        std::unique_lock<std::mutex> lk(mut);
+        cond.wait(lk,[this]{return ready;});
+    }
+
+    R get()
+    {
+        wait();
+        if(exception)
+            std::rethrow_exception(exception);
+        if constexpr(std::is_reference<R>::value)
+            return value->get();
+        else if constexpr(!std::is_void<R>::value)
+            return std::move(*value);
+    }
+};
+
+template<typename R>
+class light_promise
+{
+    light_future<R>* future;
+
+public:
+    explicit light_promise(light_future<R>* future_): future(future_) {}
+
+    light_promise(light_promise&& other): future(other.future)
+    {
+        other.future=nullptr;
+    }
+
+    light_promise& operator=(light_promise&& other)
+    {
+        if(&other!=this)
+        {
+            abandon();
+            future=other.future;
+            other.future=nullptr;
+        }
+        return *this;
+    }
+
+    light_promise(const light_promise&)=delete;
+    light_promise& operator=(const light_promise&)=delete;
+
+    ~light_promise()
+    {
+        abandon();
+    }
+
+    // 执行f并把返回值或异常交给light_future
+    template<typename F>
+    void run(F& f)
+    {
+        light_future<R>* target=future;
+        future=nullptr;
+        try
+        {
+            if constexpr(std::is_void<R>::value)
+            {
+                f();
+                target->set_value();
+            }
+            else
+            {
+                target->set_value(f());
+            }
+        }
+        catch(...)
+        {
+            target->set_exception(std::current_exception());
+        }
+    }
+
+private:
+    void abandon()
+    {
+        if(future)
+        {
+            future->set_exception(std::make_exception_ptr(
+                std::future_error(std::future_errc::broken_promise)));
+            future=nullptr;
+        }
+    }
+};
@@ -0,0 +1,501 @@
+#pragma once
+
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <atomic>
+#include <future>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <type_traits>
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include "function_wrapper.hpp"
+#include "light_future.hpp"
+#include "task_latch.hpp"
+#include "threadsafe_queue.hpp"
+#include "work_stealing_queue.hpp"
+
+class join_threads
+{
+    std::vector<std::thread>& threads;
+
+public:
+    explicit join_threads(std::vector<std::thread>& threads_):
+        threads(threads_)
+    {}
+
+    ~join_threads()
+    {
+        for(unsigned long i=0;i<threads.size();++i)
+        {
+            if(threads[i].joinable())
+                threads[i].join();
+        }
+    }
+};
+
+template<typename ResultType>
+class pool_future;
+
+class thread_pool
+{
+    typedef function_wrapper task_type;
+
+    static constexpr unsigned spin_count=64;
+    static constexpr std::size_t chunks_per_thread=4;
+
+    std::atomic_bool done;
+    threadsafe_queue<task_type> pool_work_queue;
+    std::vector<std::unique_ptr<work_stealing_queue> > queues;
+
+    // 空闲worker在sleep_cond上休眠, 只有存在休眠线程时submit才需要加锁通知
+    std::mutex sleep_mutex;
+    std::condition_variable sleep_cond;
+    std::atomic<unsigned> sleeping_count;
+    std::atomic<long> pending_count;
+    // 在pool_future::wait()中阻塞的线程数, 不为0时任务执行完要通知sleep_cond
+    std::atomic<unsigned> future_waiters;
+
+    std::vector<std::thread> threads;
+    join_threads joiner;
+
+    inline static thread_local thread_pool* local_pool=nullptr;
+    inline static thread_local work_stealing_queue* local_work_queue=nullptr;
+    inline static thread_local unsigned my_index=0;
+
+    void worker_thread(unsigned my_index_)
+    {
+        my_index=my_index_;
+        local_pool=this;
+        local_work_queue=queues[my_index].get();
+
+        unsigned spins=0;
+        while(true)
+        {
+            task_type task;
+            if(pop_task(task))
+            {
+                task();
+                notify_future_waiters();
+                spins=0;
+            }
+            else if(done)
+            {
+                break;
+            }
+            else if(++spins<spin_count)
+            {
+                std::this_thread::yield();
+            }
+            else
+            {
+                wait_for_task();
+                spins=0;
+            }
+        }
+
+        local_work_queue=nullptr;
+        local_pool=nullptr;
+    }
+
+    bool pop_task_from_local_queue(task_type& task)
+    {
+        return local_pool==this && local_work_queue->try_pop(task);
+    }
+
+    bool pop_task_from_pool_queue(task_type& task)
+    {
+        return pool_work_queue.try_pop(task);
+    }
+
+    bool pop_task_from_other_thread_queue(task_type& task)
+    {
+        for(unsigned i=0;i<queues.size();++i)
+        {
+            unsigned const index=(my_index+i+1)%queues.size();
+            if(queues[index]->try_steal(task))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool pop_task(task_type& task)
+    {
+        if(pop_task_from_local_queue(task) ||
+           pop_task_from_pool_queue(task) ||
+           pop_task_from_other_thread_queue(task))
+        {
+            --pending_count;
+            return true;
+        }
+        return false;
+    }
+
+    void push_task(task_type task)
+    {
+        if(local_pool==this)
+        {
+            local_work_queue->push(std::move(task));
+        }
+        else
+        {
+            pool_work_queue.push(std::move(task));
+        }
+
+        ++pending_count;
+        if(sleeping_count>0 || future_waiters>0)
+        {
+            std::lock_guard<std::mutex> lk(sleep_mutex);
+            sleep_cond.notify_one();
+        }
+    }
+
+    // 一次加锁把一批任务放入队列, 按任务数量唤醒休眠的worker
+    template<typename Iterator>
+    void push_tasks(Iterator first, Iterator last)
+    {
+        long const count=std::distance(first,last);
+        if(count==0)
+            return;
+
+        if(local_pool==this)
+        {
+            local_work_queue->push_range(first,last);
+        }
+        else
+        {
+            pool_work_queue.push_range(first,last);
+        }
+
+        pending_count+=count;
+        if(sleeping_count>0 || future_waiters>0)
+        {
+            std::lock_guard<std::mutex> lk(sleep_mutex);
+            if(count==1)
+                sleep_cond.notify_one();
+            else
+                sleep_cond.notify_all();
+        }
+    }
+
+    // 等待期间执行队列中的任务, 队列为空时说明剩余的块都已被其他线程取走, 可以休眠
+    void wait_helping(task_latch& latch)
+    {
+        while(!latch.try_wait())
+        {
+            if(!try_run_pending_task())
+            {
+                latch.wait();
+                break;
+            }
+        }
+    }
+
+    // 块数不少于n/grain的上限, 但不超过线程数*chunks_per_thread, 以控制任务数量
+    std::size_t chunk_count(std::size_t n, std::size_t grain) const
+    {
+        if(n==0)
+            return 0;
+        std::size_t const max_chunks=std::max<std::size_t>(1,threads.size()*chunks_per_thread);
+        std::size_t const grain_chunks=grain ? (n+grain-1)/grain : max_chunks;
+        return std::max<std::size_t>(1,std::min(std::min(grain_chunks,max_chunks),n));
+    }
+
+    // 把[0, n)切分成若干块, 第0块由调用线程执行, 其余块一次性入队, 最后等待同一个latch
+    template<typename ChunkFunction>
+    void run_chunks(std::size_t n, std::size_t grain, ChunkFunction& chunk_fn)
+    {
+        std::size_t const chunks=chunk_count(n,grain);
+        if(chunks==0)
+            return;
+
+        task_latch latch(chunks-1);
+        std::mutex error_mutex;
+        std::exception_ptr error;
+        auto run_chunk=
+            [&chunk_fn,&error_mutex,&error](std::size_t chunk, std::size_t first, std::size_t last) {
+                try
+                {
+                    chunk_fn(chunk,first,last);
+                }
+                catch(...)
+                {
+                    std::lock_guard<std::mutex> lk(error_mutex);
+                    if(!error)
+                        error=std::current_exception();
+                }
+            };
+
+        std::vector<task_type> tasks;
+        tasks.reserve(chunks-1);
+        for(std::size_t c=1;c<chunks;++c)
+        {
+            std::size_t const first=n*c/chunks;
+            std::size_t const last=n*(c+1)/chunks;
+            tasks.emplace_back([&run_chunk,&latch,c,first,last]() {
+                run_chunk(c,first,last);
+                latch.count_down();
+            });
+        }
+        push_tasks(tasks.begin(),tasks.end());
+
+        run_chunk(0,0,n/chunks);
+        wait_helping(latch);
+
+        if(error)
+            std::rethrow_exception(error);
+    }
+
+    // 任务执行完后唤醒在pool_future::wait()中阻塞的线程, 没有等待者时只多一次fence和原子读.
+    // fence与等待者在sleep_mutex内的++future_waiters配对: 要么这里看到等待者, 要么等待者看到任务已完成
+    void notify_future_waiters()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(future_waiters>0)
+        {
+            std::lock_guard<std::mutex> lk(sleep_mutex);
+            sleep_cond.notify_all();
+        }
+    }
+
+    void wait_for_task()
+    {
+        std::unique_lock<std::mutex> lk(sleep_mutex);
+        ++sleeping_count;
+        sleep_cond.wait(lk,[this]{return done || pending_count>0;});
+        --sleeping_count;
+    }
+
+    void stop()
+    {
+        done = true;
+        std::lock_guard<std::mutex> lk(sleep_mutex);
+        sleep_cond.notify_all();
+    }
+
+public:
+    thread_pool(unsigned const thread_count=std::thread::hardware_concurrency()):
+        done(false),sleeping_count(0),pending_count(0),future_waiters(0),joiner(threads)
+    {
+        try
+        {
+            for(unsigned i=0;i<thread_count;++i)
+            {
+                queues.push_back(std::unique_ptr<work_stealing_queue>(
+                                     new work_stealing_queue));
+            }
+            for(unsigned i=0;i<thread_count;++i)
+            {
+                threads.push_back(
+                    std::thread(&thread_pool::worker_thread,this,i));
+            }
+        }
+        catch(...)
+        {
+            stop();
+            throw;
+        }
+    }
+
+    ~thread_pool()
+    {
+        stop();
+    }
+
+    template<typename ResultType>
+    using task_handle=pool_future<ResultType>;
+
+    template<typename FunctionType>
+    task_handle<typename std::invoke_result<FunctionType>::type>
+    submit(FunctionType f)
+    {
+        typedef typename std::invoke_result<FunctionType>::type result_type;
+
+        std::packaged_task<result_type()> task(std::move(f));
+        std::future<result_type> res(task.get_future());
+        push_task(std::move(task));
+        return task_handle<result_type>(*this,std::move(res));
+    }
+
+    template <typename F, typename... Args>
+    task_handle<typename std::invoke_result<F, Args...>::type>
+    submit(F&& f, Args&&... args)
+    {
+        typedef typename std::invoke_result<F, Args...>::type result_type;
+
+        std::packaged_task<result_type()> task(std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+        std::future<result_type> res(task.get_future());
+        push_task(std::move(task));
+        return task_handle<result_type>(*this,std::move(res));
+    }
+
+    // 不分配共享状态的submit, 返回的light_future必须在当前作用域内接收
+    template<typename FunctionType>
+    light_future<typename std::invoke_result<FunctionType>::type>
+    submit_light(FunctionType f)
+    {
+        typedef typename std::invoke_result<FunctionType>::type result_type;
+
+        return light_future<result_type>(
+            [this,&f](light_promise<result_type> promise) {
+                push_task(
+                    [promise=std::move(promise),f=std::move(f)]() mutable {
+                        promise.run(f);
+                    });
+            });
+    }
+
+    template <typename F, typename... Args>
+    light_future<typename std::invoke_result<F, Args...>::type>
+    submit_light(F&& f, Args&&... args)
+    {
+        return submit_light(std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+    }
+
+    // 从队列中取出一个任务执行, 队列为空时返回false
+    bool try_run_pending_task()
+    {
+        task_type task;
+        if(pop_task(task))
+        {
+            task();
+            notify_future_waiters();
+            return true;
+        }
+        return false;
+    }
+
+    // 阻塞到ready()为true或队列中有可执行的任务, 供pool_future::wait()使用.
+    // push_task和任务执行完成时都会在有等待者时通知sleep_cond
+    template<typename Predicate>
+    void wait_for_progress(Predicate ready)
+    {
+        std::unique_lock<std::mutex> lk(sleep_mutex);
+        ++future_waiters;
+        sleep_cond.wait(lk,[&]{return ready() || pending_count>0;});
+        --future_waiters;
+    }
+
+    void run_pending_task()
+    {
+        if(!try_run_pending_task())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    // 对range中的每个元素调用fn(element), 所有元素处理完后返回
+    template<typename Range, typename Function>
+    void submit_bulk(Range& range, Function fn)
+    {
+        typedef decltype(std::begin(range)) iterator;
+        static_assert(std::is_base_of<std::random_access_iterator_tag,
+                      typename std::iterator_traits<iterator>::iterator_category>::value,
+                      "submit_bulk need random access range");
+
+        iterator const first=std::begin(range);
+        std::size_t const n=std::distance(first,std::end(range));
+        auto chunk_fn=[&fn,first](std::size_t, std::size_t begin, std::size_t end) {
+            for(iterator it=first+begin, last=first+end;it!=last;++it)
+                fn(*it);
+        };
+        run_chunks(n,0,chunk_fn);
+    }
+
+    // 对[begin, end)中的每个下标调用fn(i), 每块至少包含grain个下标, grain为0时自动选择
+    template<typename Index, typename Function>
+    void parallel_for(Index begin, Index end, Index grain, Function fn)
+    {
+        if(!(begin<end))
+            return;
+
+        std::size_t const n=static_cast<std::size_t>(end-begin);
+        auto chunk_fn=[&fn,begin](std::size_t, std::size_t first, std::size_t last) {
+            for(Index i=begin+static_cast<Index>(first), e=begin+static_cast<Index>(last);i!=e;++i)
+                fn(i);
+        };
+        run_chunks(n,static_cast<std::size_t>(grain),chunk_fn);
+    }
+
+    // 计算reduce(...reduce(reduce(identity, fn(begin)), fn(begin+1))..., fn(end-1)),
+    // 每块先在本地归约, 最后按块的顺序合并, 结果与块的执行顺序无关
+    template<typename Index, typename T, typename Function, typename Reduction>
+    T parallel_reduce(Index begin, Index end, Index grain, T identity, Function fn, Reduction reduce)
+    {
+        if(!(begin<end))
+            return identity;
+
+        std::size_t const n=static_cast<std::size_t>(end-begin);
+        struct partial_result { T value; };     // 避免T为bool时落入std::vector<bool>
+        std::vector<partial_result> partials(chunk_count(n,static_cast<std::size_t>(grain)),partial_result{identity});
+        auto chunk_fn=[&fn,&reduce,&partials,begin](std::size_t chunk, std::size_t first, std::size_t last) {
+            T acc=partials[chunk].value;
+            for(Index i=begin+static_cast<Index>(first), e=begin+static_cast<Index>(last);i!=e;++i)
+                acc=reduce(std::move(acc),fn(i));
+            partials[chunk].value=std::move(acc);
+        };
+        run_chunks(n,static_cast<std::size_t>(grain),chunk_fn);
+
+        T result=std::move(identity);
+        for(auto& partial: partials)
+            result=reduce(std::move(result),std::move(partial.value));
+        return result;
+    }
+};
+
+// get()/wait()在等待期间执行线程池中排队的任务, 因此worker线程内等待子任务不会占死worker,
+// 递归分治的任务也不会因为所有worker都在等待而死锁
+template<typename ResultType>
+class pool_future
+{
+    thread_pool* pool;
+    std::future<ResultType> future;
+
+public:
+    pool_future(): pool(nullptr) {}
+
+    pool_future(thread_pool& pool_, std::future<ResultType>&& future_):
+        pool(&pool_),future(std::move(future_))
+    {}
+
+    bool valid() const { return future.valid(); }
+
+    bool is_ready() const
+    {
+        return future.wait_for(std::chrono::seconds(0))==std::future_status::ready;
+    }
+
+    void wait()
+    {
+        while(!is_ready())
+        {
+            // 没有可执行的任务时说明子任务正在其他线程上运行, 阻塞到它完成或有新任务提交
+            if(!pool->try_run_pending_task())
+                pool->wait_for_progress([this]{ return is_ready(); });
+        }
+    }
+
+    template<typename Rep, typename Period>
+    std::future_status wait_for(const std::chrono::duration<Rep,Period>& rel_time) const
+    {
+        return future.wait_for(rel_time);
+    }
+
+    template<typename Clock, typename Duration>
+    std::future_status wait_until(const std::chrono::time_point<Clock,Duration>& abs_time) const
+    {
+        return future.wait_until(abs_time);
+    }
+
+    ResultType get()
+    {
+        wait();
+        return future.get();
+    }
+};
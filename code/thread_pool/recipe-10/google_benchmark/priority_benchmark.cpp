@@ -0,0 +1,88 @@
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include "thread_pool.hpp"
+
+#include "benchmark/benchmark.h"
+
+using namespace std::literals;
+
+static const long numcpu = sysconf(_SC_NPROCESSORS_CONF);
+
+void busy_for(std::chrono::microseconds d)
+{
+    auto end = std::chrono::steady_clock::now() + d;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+double to_us(std::chrono::nanoseconds d)
+{
+    return std::chrono::duration<double, std::micro>(d).count();
+}
+
+// 后台线程持续提交低优先级任务, 使队列中始终保持若干倍于线程数的积压
+class LowPriorityLoad {
+public:
+    LowPriorityLoad(thread_pool& pool, long backlog): pool_(pool), backlog_(backlog) {
+        if (backlog_ > 0) {
+            thread_ = std::thread(&LowPriorityLoad::run, this);
+        }
+    }
+
+    ~LowPriorityLoad() {
+        stop_ = true;
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        while (outstanding_ > 0) {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    void run() {
+        while (!stop_) {
+            if (outstanding_ < backlog_) {
+                ++outstanding_;
+                pool_.submit(task_priority::low, [this] { busy_for(50us); --outstanding_; });
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    thread_pool& pool_;
+    long backlog_;
+    std::atomic<bool> stop_{false};
+    std::atomic<long> outstanding_{0};
+    std::thread thread_;
+};
+
+// range(0): 低优先级积压任务数与线程数的倍数, 0表示空载
+void BM_high_priority_latency(benchmark::State& state) {
+    thread_pool pool(numcpu);
+    LowPriorityLoad load(pool, state.range(0) * numcpu);
+    std::this_thread::sleep_for(10ms);
+    pool.reset_queue_wait_histograms();
+
+    for (auto _ : state) {
+        auto probe = pool.submit(task_priority::high, [] { busy_for(10us); });
+        probe.wait_for(1h);
+        std::this_thread::sleep_for(200us);
+    }
+
+    const latency_histogram& high = pool.queue_wait_histogram(task_priority::high);
+    const latency_histogram& low = pool.queue_wait_histogram(task_priority::low);
+    state.counters["high_p50_us"] = to_us(high.percentile(0.5));
+    state.counters["high_p99_us"] = to_us(high.percentile(0.99));
+    state.counters["low_p50_us"] = to_us(low.percentile(0.5));
+    state.counters["low_p99_us"] = to_us(low.percentile(0.99));
+}
+
+BENCHMARK(BM_high_priority_latency)->Arg(0)->Arg(4)->Arg(64)->Iterations(2000)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+// 以2的幂划分桶的延迟直方图, 第b个桶统计[2^(b-1), 2^b)纳秒的样本, 可以并发record
+class latency_histogram
+{
+public:
+    static constexpr std::size_t bucket_count=48;
+
+private:
+    std::atomic<unsigned long> buckets[bucket_count];
+
+    static std::size_t bucket_index(std::chrono::nanoseconds latency)
+    {
+        long long ns=latency.count();
+        std::size_t index=0;
+        while(ns>0 && index<bucket_count-1)
+        {
+            ns>>=1;
+            ++index;
+        }
+        return index;
+    }
+
+public:
+    latency_histogram()
+    {
+        reset();
+    }
+
+    latency_histogram(const latency_histogram&)=delete;
+    latency_histogram& operator=(const latency_histogram&)=delete;
+
+    void record(std::chrono::nanoseconds latency)
+    {
+        buckets[bucket_index(latency)].fetch_add(1,std::memory_order_relaxed);
+    }
+
+    void reset()
+    {
+        for(auto& bucket: buckets)
+            bucket.store(0,std::memory_order_relaxed);
+    }
+
+    unsigned long count() const
+    {
+        unsigned long total=0;
+        for(auto& bucket: buckets)
+            total+=bucket.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    // 返回p(0~1)分位数所在桶的上界
+    std::chrono::nanoseconds percentile(double p) const
+    {
+        unsigned long counts[bucket_count];
+        unsigned long total=0;
+        for(std::size_t i=0;i<bucket_count;++i)
+        {
+            counts[i]=buckets[i].load(std::memory_order_relaxed);
+            total+=counts[i];
+        }
+        if(total==0)
+            return std::chrono::nanoseconds(0);
+
+        unsigned long const rank=static_cast<unsigned long>(p*(total-1))+1;
+        unsigned long seen=0;
+        for(std::size_t i=0;i<bucket_count;++i)
+        {
+            seen+=counts[i];
+            if(seen>=rank)
+                return std::chrono::nanoseconds(i==0 ? 0 : (1LL<<i));
+        }
+        return std::chrono::nanoseconds(1LL<<(bucket_count-1));
+    }
+};
@@ -0,0 +1,274 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <vector>
+#include "function_wrapper.hpp"
+#include "latency_histogram.hpp"
+
+enum class task_priority {
+    high = 0,
+    normal = 1,
+    low = 2,
+    deadline = 3,       // 通过截止时间提交的任务
+};
+
+// 线程池的全局任务队列, 按优先级分类保存任务:
+// 1. 已经到期的deadline任务最先执行
+// 2. 其余各类按权重做平滑加权轮询(smooth weighted round robin), 高优先级多取, 低优先级不会饿死
+// 3. deadline类内部按截止时间先后执行(EDF)
+class priority_task_queue
+{
+public:
+    typedef function_wrapper task_type;
+    typedef std::chrono::steady_clock clock;
+
+    static constexpr std::size_t class_count=4;
+
+private:
+    struct entry {
+        task_type task;
+        clock::time_point enqueue_time;
+    };
+
+    struct deadline_entry {
+        task_type task;
+        clock::time_point enqueue_time;
+        clock::time_point deadline;
+        std::uint64_t seq;      // 截止时间相同时保持FIFO
+    };
+
+    struct later_deadline {
+        bool operator()(const deadline_entry& a, const deadline_entry& b) const
+        {
+            return a.deadline!=b.deadline ? a.deadline>b.deadline : a.seq>b.seq;
+        }
+    };
+
+    mutable std::mutex mut;
+    std::deque<entry> class_queues[3];
+    std::vector<deadline_entry> deadline_heap;
+    std::uint64_t deadline_seq=0;
+
+    int weights[class_count]={8,4,1,8};
+    int credits[class_count]={0,0,0,0};
+
+    latency_histogram histograms[class_count];
+    std::atomic<unsigned long> missed_deadlines{0};
+
+    // high和deadline类中的任务数, worker不加锁就能判断是否需要让全局队列与本地任务一起轮询
+    std::atomic<std::size_t> urgent_count{0};
+
+    static bool is_urgent(std::size_t index)
+    {
+        return index==index_of(task_priority::high) || index==index_of(task_priority::deadline);
+    }
+
+    static std::size_t index_of(task_priority priority)
+    {
+        return static_cast<std::size_t>(priority);
+    }
+
+    bool class_empty(std::size_t index) const
+    {
+        return index<3 ? class_queues[index].empty() : deadline_heap.empty();
+    }
+
+    // local_pending为true时normal类即使为空也参与轮询(调用者本地队列中的子任务算作normal类)
+    std::size_t select_class(bool local_pending=false)
+    {
+        int total=0;
+        std::size_t best=class_count;
+        for(std::size_t i=0;i<class_count;++i)
+        {
+            if(class_empty(i) && !(local_pending && i==index_of(task_priority::normal)))
+                continue;
+            credits[i]+=weights[i];
+            total+=weights[i];
+            if(best==class_count || credits[i]>credits[best])
+                best=i;
+        }
+        if(best!=class_count)
+            credits[best]-=total;
+        return best;
+    }
+
+    void pop_deadline(task_type& task, clock::time_point now)
+    {
+        std::pop_heap(deadline_heap.begin(),deadline_heap.end(),later_deadline());
+        deadline_entry& e=deadline_heap.back();
+        histograms[index_of(task_priority::deadline)].record(now-e.enqueue_time);
+        if(now>e.deadline)
+            missed_deadlines.fetch_add(1,std::memory_order_relaxed);
+        task=std::move(e.task);
+        deadline_heap.pop_back();
+        urgent_count.fetch_sub(1,std::memory_order_relaxed);
+    }
+
+    void pop_class(task_type& task, std::size_t index, clock::time_point now)
+    {
+        entry& e=class_queues[index].front();
+        histograms[index].record(now-e.enqueue_time);
+        task=std::move(e.task);
+        class_queues[index].pop_front();
+        if(is_urgent(index))
+            urgent_count.fetch_sub(1,std::memory_order_relaxed);
+    }
+
+public:
+    priority_task_queue() {}
+
+    priority_task_queue(const priority_task_queue&)=delete;
+    priority_task_queue& operator=(const priority_task_queue&)=delete;
+
+    void set_weight(task_priority priority, int weight)
+    {
+        std::lock_guard<std::mutex> lk(mut);
+        weights[index_of(priority)]=std::max(weight,1);
+    }
+
+    void push(task_type task, task_priority priority=task_priority::normal)
+    {
+        if(priority==task_priority::deadline)
+        {
+            push(std::move(task),clock::now());
+            return;
+        }
+        clock::time_point const now=clock::now();
+        std::lock_guard<std::mutex> lk(mut);
+        class_queues[index_of(priority)].push_back(entry{std::move(task),now});
+        if(is_urgent(index_of(priority)))
+            urgent_count.fetch_add(1,std::memory_order_relaxed);
+    }
+
+    void push(task_type task, clock::time_point deadline)
+    {
+        clock::time_point const now=clock::now();
+        std::lock_guard<std::mutex> lk(mut);
+        deadline_heap.push_back(deadline_entry{std::move(task),now,deadline,deadline_seq++});
+        std::push_heap(deadline_heap.begin(),deadline_heap.end(),later_deadline());
+        urgent_count.fetch_add(1,std::memory_order_relaxed);
+    }
+
+    // 一次加锁压入[first, last)中的所有元素, deadline优先级与push一样以当前时间为截止时间
+    template<typename Iterator>
+    void push_range(Iterator first, Iterator last, task_priority priority=task_priority::normal)
+    {
+        if(first==last)
+            return;
+        clock::time_point const now=clock::now();
+        std::size_t const count=std::distance(first,last);
+        std::lock_guard<std::mutex> lk(mut);
+        if(priority==task_priority::deadline)
+        {
+            for(;first!=last;++first)
+            {
+                deadline_heap.push_back(deadline_entry{std::move(*first),now,now,deadline_seq++});
+                std::push_heap(deadline_heap.begin(),deadline_heap.end(),later_deadline());
+            }
+        }
+        else
+        {
+            std::deque<entry>& queue=class_queues[index_of(priority)];
+            for(;first!=last;++first)
+                queue.push_back(entry{std::move(*first),now});
+        }
+        if(is_urgent(index_of(priority)))
+            urgent_count.fetch_add(count,std::memory_order_relaxed);
+    }
+
+    bool try_pop(task_type& task)
+    {
+        std::lock_guard<std::mutex> lk(mut);
+        clock::time_point const now=clock::now();
+
+        if(!deadline_heap.empty() && deadline_heap.front().deadline<=now)
+        {
+            pop_deadline(task,now);
+            return true;
+        }
+
+        std::size_t const index=select_class();
+        if(index==class_count)
+            return false;
+
+        if(index==index_of(task_priority::deadline))
+        {
+            pop_deadline(task,now);
+            return true;
+        }
+
+        pop_class(task,index,now);
+        return true;
+    }
+
+    // 只在有high/deadline任务排队时取任务, 规则与try_pop相同(到期的deadline任务优先, 其余按SWRR),
+    // 但local(worker的本地队列, 提供empty()和try_pop())中的子任务算作normal类参与轮询, 选中normal类时先取本地任务.
+    // worker在本地队列之前调用: 高优先级任务不会被递归子任务推迟, 也不会越过权重饿死normal/low类
+    template<typename LocalQueue>
+    bool try_pop_urgent(task_type& task, LocalQueue* local)
+    {
+        if(urgent_count.load(std::memory_order_relaxed)==0)
+            return false;
+
+        std::lock_guard<std::mutex> lk(mut);
+        clock::time_point const now=clock::now();
+
+        if(!deadline_heap.empty() && deadline_heap.front().deadline<=now)
+        {
+            pop_deadline(task,now);
+            return true;
+        }
+
+        bool const local_pending=local && !local->empty();
+        std::size_t const index=select_class(local_pending);
+        if(index==class_count)
+            return false;
+
+        if(index==index_of(task_priority::deadline))
+        {
+            pop_deadline(task,now);
+            return true;
+        }
+
+        if(index==index_of(task_priority::normal) && local_pending && local->try_pop(task))
+            return true;
+        if(class_empty(index))
+            return false;       // 本地任务在检查之后被其他worker窃取
+
+        pop_class(task,index,now);
+        return true;
+    }
+
+    bool empty() const
+    {
+        std::lock_guard<std::mutex> lk(mut);
+        return class_queues[0].empty() && class_queues[1].empty() &&
+            class_queues[2].empty() && deadline_heap.empty();
+    }
+
+    // 任务从入队到被worker取出的等待时间
+    const latency_histogram& queue_wait_histogram(task_priority priority) const
+    {
+        return histograms[index_of(priority)];
+    }
+
+    void reset_histograms()
+    {
+        for(auto& histogram: histograms)
+            histogram.reset();
+        missed_deadlines.store(0,std::memory_order_relaxed);
+    }
+
+    // 被取出时已经超过截止时间的deadline任务数
+    unsigned long missed_deadline_count() const
+    {
+        return missed_deadlines.load(std::memory_order_relaxed);
+    }
+};
@@ -0,0 +1,50 @@
+#include <iostream>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+#include "thread_pool.hpp"
+
+using namespace std::literals;
+
+void busy_for(std::chrono::microseconds d)
+{
+    auto end = std::chrono::steady_clock::now() + d;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+void print_histogram(thread_pool& pool, task_priority priority, const std::string& name)
+{
+    const latency_histogram& h = pool.queue_wait_histogram(priority);
+    std::cout << name << ": count " << h.count()
+        << ", p50 <= " << std::chrono::duration_cast<std::chrono::microseconds>(h.percentile(0.5)).count() << "us"
+        << ", p99 <= " << std::chrono::duration_cast<std::chrono::microseconds>(h.percentile(0.99)).count() << "us"
+        << std::endl;
+}
+
+int main()
+{
+    thread_pool mythread_pool(2);
+
+    // 先压入大量低优先级任务, 再提交少量高优先级和带截止时间的任务
+    std::vector<thread_pool::task_handle<void>> handles;
+    for (int i = 0; i < 2000; i++) {
+        handles.push_back(mythread_pool.submit(task_priority::low, busy_for, 100us));
+    }
+    for (int i = 0; i < 20; i++) {
+        handles.push_back(mythread_pool.submit(task_priority::high, busy_for, 100us));
+        handles.push_back(mythread_pool.submit(thread_pool::clock::now() + 5ms, busy_for, 100us));
+        std::this_thread::sleep_for(2ms);
+    }
+    for (auto& h : handles) {
+        h.get();
+    }
+
+    print_histogram(mythread_pool, task_priority::high, "high");
+    print_histogram(mythread_pool, task_priority::low, "low");
+    print_histogram(mythread_pool, task_priority::deadline, "deadline");
+    std::cout << "missed deadlines: " << mythread_pool.missed_deadline_count() << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,48 @@
+#include <iostream>
+#include <chrono>
+#include <functional>
+#include <vector>
+#include "thread_pool.hpp"
+
+using namespace std::literals;
+
+// 模拟阻塞在I/O上的任务
+void blocking_io()
+{
+    std::this_thread::sleep_for(50ms);
+}
+
+int main()
+{
+    elastic_config config;
+    config.min_threads = 2;
+    config.max_threads = 16;
+    config.wait_threshold = 5ms;
+    config.idle_timeout = 200ms;
+    thread_pool mythread_pool(config);
+
+    std::cout << "threads at start: " << mythread_pool.thread_count() << std::endl;
+
+    std::vector<thread_pool::task_handle<void>> handles;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 64; i++) {
+        handles.push_back(mythread_pool.submit(blocking_io));
+    }
+    std::this_thread::sleep_for(30ms);
+    std::cout << "threads under load: " << mythread_pool.thread_count() << std::endl;
+
+    for (auto& h : handles) {
+        h.wait_for(1h);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    std::cout << "64 blocking tasks finished in " << elapsed.count() << "ms" << std::endl;
+
+    std::this_thread::sleep_for(500ms);
+    std::cout << "threads after idle: " << mythread_pool.thread_count() << std::endl;
+
+    // 缩容后再次提交任务
+    mythread_pool.submit(blocking_io).get();
+    std::cout << "threads at end: " << mythread_pool.thread_count() << std::endl;
+
+    return 0;
+}
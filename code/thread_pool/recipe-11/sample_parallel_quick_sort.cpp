@@ -0,0 +1,84 @@
+#include <iostream>
+#include <list>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include "thread_pool.hpp"
+
+// C++并发编程实战 listing 9.5, 子任务的get()在等待期间执行队列中的其他任务
+template<typename T>
+struct sorter
+{
+    thread_pool& pool;
+
+    explicit sorter(thread_pool& pool_): pool(pool_) {}
+
+    std::list<T> do_sort(std::list<T>& chunk_data)
+    {
+        if(chunk_data.empty())
+        {
+            return chunk_data;
+        }
+
+        std::list<T> result;
+        result.splice(result.begin(),chunk_data,chunk_data.begin());
+        T const& partition_val=*result.begin();
+
+        typename std::list<T>::iterator divide_point=
+            std::partition(
+                chunk_data.begin(),chunk_data.end(),
+                [&](T const& val){return val<partition_val;});
+
+        std::list<T> new_lower_chunk;
+        new_lower_chunk.splice(
+            new_lower_chunk.end(),
+            chunk_data,chunk_data.begin(),
+            divide_point);
+
+        thread_pool::task_handle<std::list<T> > new_lower=
+            pool.submit(
+                [this,chunk=std::move(new_lower_chunk)]() mutable {
+                    return do_sort(chunk);
+                });
+
+        std::list<T> new_higher(do_sort(chunk_data));
+
+        result.splice(result.end(),new_higher);
+        result.splice(result.begin(),new_lower.get());
+        return result;
+    }
+};
+
+template<typename T>
+std::list<T> parallel_quick_sort(thread_pool& pool, std::list<T> input)
+{
+    if(input.empty())
+    {
+        return input;
+    }
+    sorter<T> s(pool);
+
+    return s.do_sort(input);
+}
+
+int main()
+{
+    // 只有2个worker, 递归深度远大于线程数, 阻塞式的get()会在这里死锁
+    thread_pool mythread_pool(2);
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, 100000);
+    std::list<int> input;
+    for (int i = 0; i < 20000; i++) {
+        input.push_back(dist(gen));
+    }
+
+    auto sorted = mythread_pool.submit(
+        [&mythread_pool, &input]() { return parallel_quick_sort(mythread_pool, input); }).get();
+
+    std::cout << std::boolalpha;
+    std::cout << "size: " << sorted.size() << std::endl;
+    std::cout << "sorted: " << std::is_sorted(sorted.begin(), sorted.end()) << std::endl;
+
+    return 0;
+}
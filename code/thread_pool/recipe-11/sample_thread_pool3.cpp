@@ -0,0 +1,47 @@
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include "thread_pool.hpp"
+
+std::mutex cout_mutex;
+
+void print_line(const std::string& line)
+{
+    std::lock_guard<std::mutex> lk(cout_mutex);
+    std::cout << line << std::endl;
+}
+
+void parse_page(int site, int page)
+{
+    std::ostringstream os;
+    os << "parse site " << site << " page " << page << " in thread " << std::this_thread::get_id();
+    print_line(os.str());
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+}
+
+// 在worker线程内提交的子任务进入该worker的本地队列, 空闲worker会从中窃取
+void crawl_site(thread_pool& pool, int site)
+{
+    std::ostringstream os;
+    os << "crawl site " << site << " in thread " << std::this_thread::get_id();
+    print_line(os.str());
+    for (int page = 0; page < 8; page++) {
+        pool.submit(parse_page, site, page);
+    }
+}
+
+int main()
+{
+    thread_pool mythread_pool(4);
+
+    for (int site = 0; site < 2; site++) {
+        mythread_pool.submit(crawl_site, std::ref(mythread_pool), site);
+    }
+
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    print_line("all tasks complete");
+
+    return 0;
+}
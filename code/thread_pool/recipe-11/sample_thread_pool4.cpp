@@ -0,0 +1,50 @@
+#include <iostream>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include "thread_pool.hpp"
+
+int square(int i)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    return i * i;
+}
+
+std::string concat(std::string a, std::string b)
+{
+    return a + b;
+}
+
+void fail()
+{
+    throw std::runtime_error("task failed");
+}
+
+int main()
+{
+    thread_pool mythread_pool(4);
+
+    // light_future不可移动, 直接用submit_light的返回值初始化
+    auto f1 = mythread_pool.submit_light(square, 7);
+    auto f2 = mythread_pool.submit_light(concat, std::string("hello "), std::string("world"));
+    auto f3 = mythread_pool.submit_light(fail);
+
+    // 超过内联缓冲区大小的callable从function_block_pool分配
+    char big[256] = "large callable";
+    auto big_task = [big]() { return std::string(big); };
+    std::cout << std::boolalpha << "big task inline: "
+        << function_wrapper::is_inline<decltype(big_task)> << std::endl;
+    auto f4 = mythread_pool.submit_light(big_task);
+
+    std::cout << "square: " << f1.get() << std::endl;
+    std::cout << "concat: " << f2.get() << std::endl;
+    try {
+        f3.get();
+    } catch (const std::exception& e) {
+        std::cout << "fail: " << e.what() << std::endl;
+    }
+    std::cout << "big: " << f4.get() << std::endl;
+
+    return 0;
+}
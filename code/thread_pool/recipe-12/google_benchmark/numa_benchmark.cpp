@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <vector>
+#include "numa_thread_pool.hpp"
+
+#include "benchmark/benchmark.h"
+
+// 每个分块的大小, 远大于末级缓存, 任务受内存带宽限制
+static const std::size_t kChunkBytes = 16 << 20;
+
+struct Chunk {
+    std::unique_ptr<long[]> data;
+    std::size_t node = 0;
+};
+
+long stream_sum(const long* p)
+{
+    return std::accumulate(p, p + kChunkBytes / sizeof(long), 0L);
+}
+
+// 分块由线程池中的任务分配并首次写入, 页面落在执行该任务的worker所在节点
+template <typename Submit>
+std::vector<Chunk> make_chunks(std::size_t count, Submit submit)
+{
+    std::vector<Chunk> chunks(count);
+    for (std::size_t i = 0; i < count; i++) {
+        chunks[i].node = i;
+        submit(i, [&chunks, i] {
+            chunks[i].data.reset(new long[kChunkBytes / sizeof(long)]);
+            std::memset(chunks[i].data.get(), 1, kChunkBytes);
+        }).get();
+    }
+    return chunks;
+}
+
+template <typename Submit>
+void stream_chunks(benchmark::State& state, std::vector<Chunk>& chunks, Submit submit)
+{
+    for (auto _ : state) {
+        std::vector<thread_pool::task_handle<long>> results;
+        results.reserve(chunks.size());
+        for (auto& chunk : chunks) {
+            const long* p = chunk.data.get();
+            results.push_back(submit(chunk.node, [p] { return stream_sum(p); }));
+        }
+        long sum = 0;
+        for (auto& result : results) {
+            sum += result.get();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * chunks.size() * kChunkBytes);
+}
+
+std::size_t chunk_count(const numa_topology& topology)
+{
+    return std::max(allowed_cpus().size() * 2, topology.node_count());
+}
+
+// 不绑核的线程池, worker可被调度到任意节点
+void BM_unpinned_pool(benchmark::State& state)
+{
+    numa_topology topology;
+    thread_pool pool(allowed_cpus().size());
+    auto submit = [&pool](std::size_t, auto f) { return pool.submit(std::move(f)); };
+    auto chunks = make_chunks(chunk_count(topology), submit);
+    stream_chunks(state, chunks, submit);
+}
+
+// worker逐个绑定到CPU, 但任务不区分节点
+void BM_pinned_pool(benchmark::State& state)
+{
+    numa_topology topology;
+    cpu_affinity affinity;
+    affinity.cpus = allowed_cpus();
+    thread_pool pool(affinity.cpus.size(), affinity);
+    auto submit = [&pool](std::size_t, auto f) { return pool.submit(std::move(f)); };
+    auto chunks = make_chunks(chunk_count(topology), submit);
+    stream_chunks(state, chunks, submit);
+}
+
+// 每个节点一个子线程池, 分块在所属节点上分配和读取
+void BM_numa_pool(benchmark::State& state)
+{
+    numa_thread_pool pool;
+    auto submit = [&pool](std::size_t node, auto f) { return pool.submit(node, std::move(f)); };
+    auto chunks = make_chunks(chunk_count(pool.get_topology()), submit);
+    for (auto& chunk : chunks) {
+        chunk.node %= pool.node_count();
+    }
+    stream_chunks(state, chunks, submit);
+}
+
+BENCHMARK(BM_unpinned_pool)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_pinned_pool)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_numa_pool)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "numa_topology.hpp"
+#include "thread_pool.hpp"
+
+// 每个NUMA节点一个子线程池, 子线程池的worker绑定在该节点的CPU上.
+// 任务按节点提示提交, 在数据所在节点上执行; 单节点机器上等价于一个绑核的thread_pool
+class numa_thread_pool
+{
+    numa_topology topology;
+    std::vector<std::unique_ptr<thread_pool> > pools;
+
+public:
+    // threads_per_node为0时每个节点的worker数等于该节点可用的CPU数
+    explicit numa_thread_pool(unsigned threads_per_node=0, bool pin_per_worker=true)
+    {
+        for(std::size_t node=0;node<topology.node_count();++node)
+        {
+            cpu_affinity affinity;
+            affinity.cpus=topology.cpus_of(node);
+            affinity.pin_per_worker=pin_per_worker;
+            unsigned const thread_count=threads_per_node ?
+                threads_per_node : static_cast<unsigned>(affinity.cpus.size());
+            pools.push_back(std::unique_ptr<thread_pool>(new thread_pool(thread_count,affinity)));
+        }
+    }
+
+    numa_thread_pool(const numa_thread_pool&)=delete;
+    numa_thread_pool& operator=(const numa_thread_pool&)=delete;
+
+    const numa_topology& get_topology() const
+    {
+        return topology;
+    }
+
+    std::size_t node_count() const
+    {
+        return pools.size();
+    }
+
+    thread_pool& node_pool(std::size_t node)
+    {
+        return *pools[node%pools.size()];
+    }
+
+    // 提交到指定节点
+    template<typename FunctionType>
+    thread_pool::task_handle<typename std::invoke_result<FunctionType>::type>
+    submit(std::size_t node, FunctionType f)
+    {
+        return node_pool(node).submit(std::move(f));
+    }
+
+    // 提交到调用线程当前所在的节点
+    template<typename FunctionType>
+    thread_pool::task_handle<typename std::invoke_result<FunctionType>::type>
+    submit(FunctionType f)
+    {
+        return submit(topology.current_node(),std::move(f));
+    }
+
+    // 提交到data所在内存页的节点
+    template<typename FunctionType>
+    thread_pool::task_handle<typename std::invoke_result<FunctionType>::type>
+    submit_near(const void* data, FunctionType f)
+    {
+        return submit(topology.node_of_address(data),std::move(f));
+    }
+};
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+// 当前进程允许使用的CPU列表
+inline std::vector<int> allowed_cpus()
+{
+    std::vector<int> cpus;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if(sched_getaffinity(0,sizeof(set),&set)==0)
+    {
+        for(int cpu=0;cpu<CPU_SETSIZE;++cpu)
+        {
+            if(CPU_ISSET(cpu,&set))
+                cpus.push_back(cpu);
+        }
+    }
+#endif
+    if(cpus.empty())
+    {
+        unsigned const n=std::max(1u,std::thread::hardware_concurrency());
+        for(unsigned cpu=0;cpu<n;++cpu)
+            cpus.push_back(static_cast<int>(cpu));
+    }
+    return cpus;
+}
+
+// 把调用线程绑定到cpus上, 不支持或失败时返回false, 线程保持原来的亲和性
+inline bool bind_current_thread(const std::vector<int>& cpus)
+{
+#ifdef __linux__
+    if(cpus.empty())
+        return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for(int cpu: cpus)
+    {
+        if(cpu>=0 && cpu<CPU_SETSIZE)
+            CPU_SET(cpu,&set);
+    }
+    return pthread_setaffinity_np(pthread_self(),sizeof(set),&set)==0;
+#else
+    (void)cpus;
+    return false;
+#endif
+}
+
+// 从/sys/devices/system/node读取NUMA拓扑, 读不到时(非Linux或单节点内核)退化为包含全部CPU的单个节点
+class numa_topology
+{
+    std::vector<std::vector<int> > node_cpus;
+    std::vector<int> node_ids;      // 每个节点在/sys中的编号
+
+    // 解析"0-3,8-11"格式的编号列表(CPU列表和节点列表)
+    static std::vector<int> parse_range_list(const std::string& text)
+    {
+        std::vector<int> ids;
+        std::istringstream is(text);
+        std::string range;
+        while(std::getline(is,range,','))
+        {
+            if(range.empty() || range=="\n")
+                continue;
+            std::size_t const dash=range.find('-');
+            int const first=std::stoi(range.substr(0,dash));
+            int const last=dash==std::string::npos ? first : std::stoi(range.substr(dash+1));
+            for(int id=first;id<=last;++id)
+                ids.push_back(id);
+        }
+        return ids;
+    }
+
+    // 读取文件的第一行, 文件不存在时返回false
+    static bool read_line(const std::string& path, std::string& text)
+    {
+        std::ifstream in(path);
+        return in && std::getline(in,text);
+    }
+
+public:
+    numa_topology()
+    {
+        std::string const sysfs_node="/sys/devices/system/node/";
+        std::vector<int> const allowed=allowed_cpus();
+
+        // 节点编号可能不连续(离线节点, CXL内存节点等), 从online(或possible)列表中取编号, 而不是从0开始逐个尝试
+        std::string text;
+        std::vector<int> nodes;
+        if(read_line(sysfs_node+"online",text) || read_line(sysfs_node+"possible",text))
+            nodes=parse_range_list(text);
+
+        for(int node: nodes)
+        {
+            if(!read_line(sysfs_node+"node"+std::to_string(node)+"/cpulist",text))
+                continue;
+
+            // 只保留进程允许使用的CPU, 没有可用CPU的节点(如纯内存节点)跳过
+            std::vector<int> cpus;
+            for(int cpu: parse_range_list(text))
+            {
+                if(std::find(allowed.begin(),allowed.end(),cpu)!=allowed.end())
+                    cpus.push_back(cpu);
+            }
+            if(!cpus.empty())
+            {
+                node_cpus.push_back(cpus);
+                node_ids.push_back(node);
+            }
+        }
+        if(node_cpus.empty())
+        {
+            node_cpus.push_back(allowed);
+            node_ids.push_back(0);
+        }
+    }
+
+    std::size_t node_count() const
+    {
+        return node_cpus.size();
+    }
+
+    const std::vector<int>& cpus_of(std::size_t node) const
+    {
+        return node_cpus[node%node_cpus.size()];
+    }
+
+    std::size_t node_of_cpu(int cpu) const
+    {
+        for(std::size_t node=0;node<node_cpus.size();++node)
+        {
+            if(std::find(node_cpus[node].begin(),node_cpus[node].end(),cpu)!=node_cpus[node].end())
+                return node;
+        }
+        return 0;
+    }
+
+    // 调用线程当前所在的节点
+    std::size_t current_node() const
+    {
+#ifdef __linux__
+        int const cpu=sched_getcpu();
+        if(cpu>=0)
+            return node_of_cpu(cpu);
+#endif
+        return 0;
+    }
+
+    // addr所在页面的物理内存节点, 页面尚未分配或内核不支持时返回current_node()
+    std::size_t node_of_address(const void* addr) const
+    {
+#if defined(__linux__) && defined(SYS_move_pages)
+        if(node_cpus.size()>1)
+        {
+            long const page_size=sysconf(_SC_PAGESIZE);
+            void* page=reinterpret_cast<void*>(
+                reinterpret_cast<unsigned long>(addr)&~static_cast<unsigned long>(page_size-1));
+            int status=-1;
+            if(syscall(SYS_move_pages,0,1UL,&page,nullptr,&status,0)==0 && status>=0)
+            {
+                auto it=std::find(node_ids.begin(),node_ids.end(),status);
+                if(it!=node_ids.end())
+                    return it-node_ids.begin();
+            }
+        }
+#else
+        (void)addr;
+#endif
+        return current_node();
+    }
+};
@@ -0,0 +1,48 @@
+#include <iostream>
+#include <numeric>
+#include <memory>
+#include <vector>
+#include "numa_thread_pool.hpp"
+
+int main()
+{
+    numa_thread_pool mythread_pool;
+    const numa_topology& topology = mythread_pool.get_topology();
+
+    std::cout << "numa nodes: " << topology.node_count() << std::endl;
+    for (std::size_t node = 0; node < topology.node_count(); node++) {
+        std::cout << "node " << node << " cpus:";
+        for (int cpu : topology.cpus_of(node)) {
+            std::cout << " " << cpu;
+        }
+        std::cout << std::endl;
+    }
+
+    // 每个节点的数据由该节点的worker首次写入(first touch), 之后的计算也提交到该节点
+    const std::size_t kCount = 1 << 20;
+    std::vector<std::unique_ptr<long[]>> data(topology.node_count());
+    for (std::size_t node = 0; node < topology.node_count(); node++) {
+        mythread_pool.submit(node, [&data, node, kCount] {
+            data[node].reset(new long[kCount]);
+            std::iota(data[node].get(), data[node].get() + kCount, 0L);
+        }).get();
+    }
+
+    for (std::size_t node = 0; node < topology.node_count(); node++) {
+        const long* p = data[node].get();
+        long sum = mythread_pool.submit_near(p, [p, kCount] {
+            return std::accumulate(p, p + kCount, 0L);
+        }).get();
+        std::cout << "node " << node << " data on node " << topology.node_of_address(p)
+            << ", sum " << sum << std::endl;
+    }
+
+    // 普通线程池也可以单独绑核
+    cpu_affinity affinity;
+    affinity.cpus = topology.cpus_of(0);
+    thread_pool pinned_pool(2, affinity);
+    std::cout << "pinned task on node " << pinned_pool.submit([&topology] { return topology.current_node(); }).get()
+        << std::endl;
+
+    return 0;
+}
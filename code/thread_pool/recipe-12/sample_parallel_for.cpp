@@ -0,0 +1,50 @@
+#include <iostream>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "thread_pool.hpp"
+
+int main()
+{
+    thread_pool mythread_pool(4);
+
+    std::vector<double> values(1000000);
+    mythread_pool.parallel_for(std::size_t(0), values.size(), std::size_t(10000),
+        [&values](std::size_t i) {
+            values[i] = i * 0.5;
+        });
+
+    double sum = mythread_pool.parallel_reduce(std::size_t(0), values.size(), std::size_t(0), 0.0,
+        [&values](std::size_t i) { return values[i]; },
+        std::plus<double>());
+    std::cout << "parallel_reduce: " << sum << std::endl;
+    std::cout << "std::accumulate: " << std::accumulate(values.begin(), values.end(), 0.0) << std::endl;
+
+    std::vector<std::string> words{"thread", "pool", "bulk", "submit"};
+    mythread_pool.submit_bulk(words, [](std::string& word) { word += "!"; });
+    for (auto& word : words) {
+        std::cout << word << " ";
+    }
+    std::cout << std::endl;
+
+    // 嵌套的parallel_for在worker线程内执行, 等待时会帮忙执行队列中的块
+    std::vector<int> matrix(100 * 100);
+    mythread_pool.parallel_for(0, 100, 1, [&](int row) {
+        mythread_pool.parallel_for(0, 100, 10, [&](int col) {
+            matrix[row * 100 + col] = row * col;
+        });
+    });
+    std::cout << "matrix[99][99]: " << matrix[99 * 100 + 99] << std::endl;
+
+    try {
+        mythread_pool.parallel_for(0, 100, 1, [](int i) {
+            if (i == 42) throw std::runtime_error("bad index 42");
+        });
+    } catch (const std::exception& e) {
+        std::cout << "parallel_for: " << e.what() << std::endl;
+    }
+
+    return 0;
+}
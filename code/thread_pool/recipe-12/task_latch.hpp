@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <condition_variable>
+
+// 一次性计数器, 计数减到0后wait()返回.
+// 计数在锁内修改, 等待方返回后即可安全析构latch.
+class task_latch
+{
+    mutable std::mutex mut;
+    std::condition_variable cond;
+    std::size_t count;
+
+public:
+    explicit task_latch(std::size_t count_): count(count_) {}
+
+    ~task_latch()
+    {
+        std::lock_guard<std::mutex> lk(mut);
+    }
+
+    task_latch(const task_latch&)=delete;
+    task_latch& operator=(const task_latch&)=delete;
+
+    void count_down()
+    {
+        std::lock_guard<std::mutex> lk(mut);
+        if(--count==0)
+            cond.notify_all();
+    }
+
+    bool try_wait() const
+    {
+        std::lock_guard<std::mutex> lk(mut);
+        return count==0;
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lk(mut);
+        cond.wait(lk,[this]{return count==0;});
+    }
+};
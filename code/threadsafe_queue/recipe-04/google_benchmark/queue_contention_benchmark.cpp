@@ -0,0 +1,70 @@
+#include <unistd.h>
+
+#include <thread>
+#include <vector>
+#include "threadsafe_queue.hpp"
+
+#include "benchmark/benchmark.h"
+
+static const long numcpu = sysconf(_SC_NPROCESSORS_CONF);
+
+const long kItemsPerProducer = 100000;
+
+// range(0)个生产者和range(1)个消费者同时操作同一个队列,
+// 生产者结束后为每个消费者放入一个-1作为结束标记
+void BM_producers_consumers(benchmark::State& state) {
+    int const producers = state.range(0);
+    int const consumers = state.range(1);
+    for (auto _ : state) {
+        threadsafe_queue<long> queue;
+        std::vector<std::thread> threads;
+        std::vector<long> sums(consumers);
+        for (int i = 0; i < consumers; i++) {
+            threads.emplace_back([&queue, &sums, i] {
+                long value;
+                while (true) {
+                    queue.wait_and_pop(value);
+                    if (value < 0) {
+                        break;
+                    }
+                    sums[i] += value;
+                }
+            });
+        }
+        std::vector<std::thread> producer_threads;
+        for (int i = 0; i < producers; i++) {
+            producer_threads.emplace_back([&queue] {
+                for (long n = 0; n < kItemsPerProducer; n++) {
+                    queue.push(n);
+                }
+            });
+        }
+        for (auto& t : producer_threads) {
+            t.join();
+        }
+        for (int i = 0; i < consumers; i++) {
+            queue.push(-1);
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        benchmark::DoNotOptimize(sums.data());
+    }
+    state.SetItemsProcessed(state.iterations() * producers * kItemsPerProducer);
+}
+
+static void ProducersConsumers(benchmark::internal::Benchmark* b) {
+    for (long p = 1; p <= numcpu; p *= 2) {
+        for (long c = 1; c <= numcpu; c *= 2) {
+            b->Args({p, c});
+        }
+    }
+    if (numcpu < 4) {
+        b->Args({4, 4});
+    }
+}
+
+BENCHMARK(BM_producers_consumers)->Apply(ProducersConsumers)->ArgNames({"producers", "consumers"})
+    ->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,279 @@
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+// 有界无锁多生产者多消费者队列(基于序号槽的环形数组).
+// 每个槽带一个序号, 生产者/消费者通过CAS抢占入队/出队位置, 再根据槽序号判断槽是否可用.
+// 接口与基于互斥量的版本保持一致, 队列满时push阻塞, 空时wait_and_pop阻塞:
+// 先自旋重试, 仍然不成功再在条件变量上休眠, 只有存在休眠线程时才需要加锁通知.
+template<typename T>
+class threadsafe_queue {
+private:
+    static constexpr std::size_t cache_line_size=64;
+    static constexpr unsigned spin_count=64;
+
+    // 每个槽独占缓存行, 相邻槽的读写不会互相失效
+    struct alignas(cache_line_size) slot {
+        std::atomic<std::size_t> sequence;
+        typename std::aligned_storage<sizeof(T),alignof(T)>::type storage;
+
+        T* item()
+        {
+            return std::launder(reinterpret_cast<T*>(&storage));
+        }
+    };
+
+    std::size_t const mask;
+    std::unique_ptr<slot[]> slots;
+
+    alignas(cache_line_size) std::atomic<std::size_t> enqueue_pos;
+    alignas(cache_line_size) std::atomic<std::size_t> dequeue_pos;
+
+    alignas(cache_line_size) std::mutex park_mutex;
+    std::condition_variable not_empty_cond;
+    std::condition_variable not_full_cond;
+    std::atomic<unsigned> waiting_consumers;
+    std::atomic<unsigned> waiting_producers;
+
+    static std::size_t round_up_capacity(std::size_t capacity)
+    {
+        std::size_t n=2;
+        while(n<capacity)
+            n*=2;
+        return n;
+    }
+
+    // 抢占一个可写的槽, 队列满时返回nullptr
+    slot* claim_write_slot(std::size_t& pos)
+    {
+        pos=enqueue_pos.load(std::memory_order_relaxed);
+        while(true)
+        {
+            slot* s=&slots[pos&mask];
+            std::size_t const seq=s->sequence.load(std::memory_order_acquire);
+            std::intptr_t const diff=static_cast<std::intptr_t>(seq)-static_cast<std::intptr_t>(pos);
+            if(diff==0)
+            {
+                if(enqueue_pos.compare_exchange_weak(pos,pos+1,std::memory_order_relaxed))
+                    return s;
+            }
+            else if(diff<0)
+            {
+                return nullptr;
+            }
+            else
+            {
+                pos=enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // 抢占一个可读的槽, 队列空时返回nullptr
+    slot* claim_read_slot(std::size_t& pos)
+    {
+        pos=dequeue_pos.load(std::memory_order_relaxed);
+        while(true)
+        {
+            slot* s=&slots[pos&mask];
+            std::size_t const seq=s->sequence.load(std::memory_order_acquire);
+            std::intptr_t const diff=static_cast<std::intptr_t>(seq)-static_cast<std::intptr_t>(pos+1);
+            if(diff==0)
+            {
+                if(dequeue_pos.compare_exchange_weak(pos,pos+1,std::memory_order_relaxed))
+                    return s;
+            }
+            else if(diff<0)
+            {
+                return nullptr;
+            }
+            else
+            {
+                pos=dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void publish_write(slot* s, std::size_t pos)
+    {
+        s->sequence.store(pos+1,std::memory_order_release);
+        wake(waiting_consumers,not_empty_cond);
+    }
+
+    void release_read(slot* s, std::size_t pos)
+    {
+        s->item()->~T();
+        s->sequence.store(pos+mask+1,std::memory_order_release);
+        wake(waiting_producers,not_full_cond);
+    }
+
+    // 发布之后再检查休眠计数, 与park中先增加计数再重试的顺序配对, 不会丢失唤醒
+    void wake(std::atomic<unsigned>& waiting, std::condition_variable& cond)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(waiting.load(std::memory_order_relaxed)>0)
+        {
+            std::lock_guard<std::mutex> lk(park_mutex);
+            cond.notify_one();
+        }
+    }
+
+    // attempt在锁外执行(它内部的唤醒需要park_mutex), 休眠时只用ready检查位置,
+    // 被唤醒后回到锁外重新抢占. 休眠过的线程成功后如果还有剩余, 把唤醒传给下一个休眠的线程
+    template<typename Attempt, typename Ready>
+    void spin_then_park(std::atomic<unsigned>& waiting, std::condition_variable& cond,
+                        Attempt attempt, Ready ready)
+    {
+        bool parked=false;
+        while(true)
+        {
+            for(unsigned i=0;i<spin_count;++i)
+            {
+                if(attempt())
+                {
+                    if(parked && ready())
+                        wake(waiting,cond);
+                    return;
+                }
+                std::this_thread::yield();
+            }
+
+            parked=true;
+            std::unique_lock<std::mutex> lk(park_mutex);
+            waiting.fetch_add(1,std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            cond.wait(lk,ready);
+            waiting.fetch_sub(1,std::memory_order_relaxed);
+        }
+    }
+
+    bool readable() const
+    {
+        std::size_t const pos=dequeue_pos.load(std::memory_order_relaxed);
+        return slots[pos&mask].sequence.load(std::memory_order_acquire)==pos+1;
+    }
+
+    // 休眠条件按入队/出队位置判断, 已被抢占但尚未发布(释放)的槽也算在内.
+    // 只看dequeue_pos(enqueue_pos)处的槽时, 乱序发布唤醒的线程会发现该槽未就绪而再次休眠, 吞掉这次通知
+    bool has_items() const
+    {
+        std::size_t const head=dequeue_pos.load(std::memory_order_relaxed);
+        return enqueue_pos.load(std::memory_order_relaxed)!=head;
+    }
+
+    bool has_space() const
+    {
+        std::size_t const head=dequeue_pos.load(std::memory_order_relaxed);
+        return enqueue_pos.load(std::memory_order_relaxed)-head<=mask;
+    }
+
+    template<typename U>
+    bool try_emplace(U&& new_value)
+    {
+        std::size_t pos;
+        slot* s=claim_write_slot(pos);
+        if(!s)
+            return false;
+        new (&s->storage) T(std::forward<U>(new_value));
+        publish_write(s,pos);
+        return true;
+    }
+
+public:
+    // capacity向上取整为2的幂
+    explicit threadsafe_queue(std::size_t capacity=1024):
+        mask(round_up_capacity(capacity)-1),slots(new slot[mask+1]),
+        enqueue_pos(0),dequeue_pos(0),waiting_consumers(0),waiting_producers(0)
+    {
+        for(std::size_t i=0;i<=mask;++i)
+            slots[i].sequence.store(i,std::memory_order_relaxed);
+    }
+
+    ~threadsafe_queue()
+    {
+        while(try_pop())
+        {
+        }
+    }
+
+    // 无锁队列无法在其他线程并发读写时得到一致的快照, 不提供复制
+    threadsafe_queue(threadsafe_queue const&)=delete;
+    threadsafe_queue& operator=(threadsafe_queue const&)=delete;
+
+    std::size_t capacity() const
+    {
+        return mask+1;
+    }
+
+    // 队列满时阻塞, 直到有空槽
+    void push(T new_value)
+    {
+        spin_then_park(waiting_producers,not_full_cond,
+                       [&]{return try_emplace(std::move(new_value));},
+                       [this]{return has_space();});
+    }
+
+    // 队列满时立即返回false, new_value保持不变
+    bool try_push(T const& new_value)
+    {
+        return try_emplace(new_value);
+    }
+
+    bool try_push(T&& new_value)
+    {
+        return try_emplace(std::move(new_value));
+    }
+
+    void wait_and_pop(T& value)
+    {
+        spin_then_park(waiting_consumers,not_empty_cond,
+                       [&]{return try_pop(value);},
+                       [this]{return has_items();});
+    }
+
+    // 直接返回元素, 不再为每个元素分配shared_ptr
+    T wait_and_pop()
+    {
+        std::optional<T> res;
+        spin_then_park(waiting_consumers,not_empty_cond,
+                       [&]{return (res=try_pop()).has_value();},
+                       [this]{return has_items();});
+        return std::move(*res);
+    }
+
+    bool try_pop(T& value)
+    {
+        std::size_t pos;
+        slot* s=claim_read_slot(pos);
+        if(!s)
+            return false;
+        value=std::move(*s->item());
+        release_read(s,pos);
+        return true;
+    }
+
+    std::optional<T> try_pop()
+    {
+        std::size_t pos;
+        slot* s=claim_read_slot(pos);
+        if(!s)
+            return std::nullopt;
+        std::optional<T> res(std::move(*s->item()));
+        release_read(s,pos);
+        return res;
+    }
+
+    // 并发修改时只是一个瞬时的近似结果
+    bool empty() const
+    {
+        return !readable();
+    }
+};
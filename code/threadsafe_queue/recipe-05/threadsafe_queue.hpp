@@ -0,0 +1,159 @@
+#pragma once
+#include <mutex>
+#include <condition_variable>
+#include <queue>
+#include <memory>
+#include <limits>
+#include <algorithm>
+#include <iterator>
+
+// 只在队列由空变为非空且有线程等待时通知, 被唤醒的线程取走元素后如果还有剩余再接力唤醒下一个,
+// 连续push时不会每个元素都触发一次notify_one.
+// push_range/pop_bulk/drain_into一次加锁搬运多个元素.
+template<typename T>
+class threadsafe_queue {
+private:
+    mutable std::mutex mut;
+    std::queue<T> data_queue;
+    std::condition_variable data_cond;
+    size_t waiting_count = 0;
+
+    void wait_not_empty(std::unique_lock<std::mutex>& lk)
+    {
+        ++waiting_count;
+        data_cond.wait(lk,[this]{return !data_queue.empty();});
+        --waiting_count;
+    }
+
+    // old_size为放入元素之前的队列长度, 调用时持有mut
+    void notify_pushed(size_t old_size)
+    {
+        if(old_size==0 && waiting_count>0)
+        {
+            size_t const n=std::min(data_queue.size(),waiting_count);
+            for(size_t i=0;i<n;++i)
+                data_cond.notify_one();
+        }
+    }
+
+    // 取走元素后队列中还有剩余, 接力唤醒下一个等待线程
+    void notify_popped()
+    {
+        if(!data_queue.empty() && waiting_count>0)
+            data_cond.notify_one();
+    }
+
+    template<typename OutputIterator>
+    size_t pop_locked(OutputIterator out, size_t max_n)
+    {
+        size_t const n=std::min(data_queue.size(),max_n);
+        for(size_t i=0;i<n;++i)
+        {
+            *out=std::move(data_queue.front());
+            ++out;
+            data_queue.pop();
+        }
+        if(n>0)
+            notify_popped();
+        return n;
+    }
+
+public:
+    threadsafe_queue()
+    {}
+
+    threadsafe_queue(threadsafe_queue const& other)
+    {
+        std::lock_guard<std::mutex> lk(other.mut);
+        data_queue=other.data_queue;
+    }
+
+    void push(T new_value)
+    {
+        std::lock_guard<std::mutex> lk(mut);
+        size_t const old_size=data_queue.size();
+        data_queue.push(std::move(new_value));
+        notify_pushed(old_size);
+    }
+
+    // 把[first, last)中的元素移入队列, 只加一次锁
+    template<typename Iterator>
+    void push_range(Iterator first, Iterator last)
+    {
+        if(first==last)
+            return;
+        std::lock_guard<std::mutex> lk(mut);
+        size_t const old_size=data_queue.size();
+        for(;first!=last;++first)
+            data_queue.push(std::move(*first));
+        notify_pushed(old_size);
+    }
+
+    void wait_and_pop(T& value)
+    {
+        std::unique_lock<std::mutex> lk(mut);
+        wait_not_empty(lk);
+        value=std::move(data_queue.front());
+        data_queue.pop();
+        notify_popped();
+    }
+
+    std::shared_ptr<T> wait_and_pop()
+    {
+        std::unique_lock<std::mutex> lk(mut);
+        wait_not_empty(lk);
+        std::shared_ptr<T> res(std::make_shared<T>(std::move(data_queue.front())));
+        data_queue.pop();
+        notify_popped();
+        return res;
+    }
+
+    // 等待队列非空, 然后一次取出最多max_n个元素写入out, 返回取出的个数
+    template<typename OutputIterator>
+    size_t pop_bulk(OutputIterator out, size_t max_n)
+    {
+        std::unique_lock<std::mutex> lk(mut);
+        wait_not_empty(lk);
+        return pop_locked(out,max_n);
+    }
+
+    template<typename OutputIterator>
+    size_t try_pop_bulk(OutputIterator out, size_t max_n)
+    {
+        std::lock_guard<std::mutex> lk(mut);
+        return pop_locked(out,max_n);
+    }
+
+    // 等待队列非空, 然后把队列中的全部元素追加到container末尾, 返回取出的个数
+    template<typename Container>
+    size_t drain_into(Container& container)
+    {
+        return pop_bulk(std::back_inserter(container),std::numeric_limits<size_t>::max());
+    }
+
+    bool try_pop(T& value)
+    {
+        std::lock_guard<std::mutex> lk(mut);
+        if(data_queue.empty())
+            return false;
+        value=std::move(data_queue.front());
+        data_queue.pop();
+        return true;
+    }
+
+    std::shared_ptr<T> try_pop()
+    {
+        std::lock_guard<std::mutex> lk(mut);
+        if(data_queue.empty())
+            return std::shared_ptr<T>();
+        std::shared_ptr<T> res(std::make_shared<T>(std::move(data_queue.front())));
+        data_queue.pop();
+        return res;
+    }
+
+    bool empty() const
+    {
+        std::lock_guard<std::mutex> lk(mut);
+        return data_queue.empty();
+    }
+};
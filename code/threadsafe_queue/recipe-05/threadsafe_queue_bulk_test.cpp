@@ -0,0 +1,46 @@
+#include <thread>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <vector>
+
+#include "threadsafe_queue.hpp"
+
+// 生产者每次放入一批数据, 消费者一次取走队列中的全部数据
+void put_id(threadsafe_queue<int>& queue) {
+    int i = 0;
+    while (true) {
+        std::vector<int> batch;
+        for (int j = 0; j < 3; j++) {
+            batch.push_back(++i);
+        }
+        std::cout << "添加数据 " << batch.front() << "-" << batch.back() << std::endl;
+        queue.push_range(batch.begin(), batch.end());
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+}
+
+void get_id(int thread_id, threadsafe_queue<int>& queue) {
+    while (true) {
+        std::deque<int> values;
+        queue.drain_into(values);
+        std::cout << "线程: " << thread_id << " 取值";
+        for (int i : values) {
+            std::cout << " " << i;
+        }
+        std::cout << std::endl;
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    }
+}
+
+int main() {
+    threadsafe_queue<int> id_queue;
+    auto Th1 = std::thread(put_id, std::ref(id_queue));
+
+    auto Th2 = std::thread(get_id, 2, std::ref(id_queue));
+    auto Th3 = std::thread(get_id, 3, std::ref(id_queue));
+
+    Th2.join();
+    Th1.join();
+    Th3.join();
+}
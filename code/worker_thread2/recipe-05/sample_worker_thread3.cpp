@@ -0,0 +1,27 @@
+#include <iostream>
+#include <chrono>
+#include <functional>
+#include <string>
+#include "worker_thread.hpp"
+
+int square(int i)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    return i * i;
+}
+
+int main()
+{
+    worker_thread mythread;
+
+    // light_future不可移动, 直接用submit_light的返回值初始化
+    auto f1 = mythread.submit_light(std::bind(square, 7));
+    auto f2 = mythread.submit_light([]() { return std::string("hello world"); });
+    auto f3 = mythread.submit_light([]() { std::cout << "void task" << std::endl; });
+
+    std::cout << "square: " << f1.get() << std::endl;
+    std::cout << "string: " << f2.get() << std::endl;
+    f3.get();
+
+    return 0;
+}
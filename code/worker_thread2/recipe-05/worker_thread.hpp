@@ -0,0 +1,76 @@
+#pragma once
+
+#include <thread>
+#include <atomic>
+#include <future>
+
+#include "threadsafe_queue.hpp"
+#include "function_wrapper.hpp"
+#include "light_future.hpp"
+
+class worker_thread {
+private:
+    std::atomic_bool done;
+    threadsafe_queue<function_wrapper> work_queue;
+    std::thread work_thread;
+
+    void work_loop()
+    {
+        while(!done)
+        {
+            function_wrapper task;
+            work_queue.wait_and_pop(task);
+            task();
+        }
+    }
+
+    void stop()
+    {
+        done = true;
+        auto stop_task =
+            [this]() {
+                this->done = true;
+            };
+        work_queue.push(std::move(stop_task));
+    }
+
+public:
+    worker_thread(): done(false)
+    {
+        work_thread = std::thread(&worker_thread::work_loop, this);
+    }
+
+    ~worker_thread()
+    {
+        stop();
+        work_thread.join();
+    }
+
+    template<typename FunctionType>
+    std::future<typename std::result_of<FunctionType()>::type>
+    submit(FunctionType f)
+    {
+        typedef typename std::result_of<FunctionType()>::type result_type;
+        
+        std::packaged_task<result_type()> task(std::move(f));
+        std::future<result_type> res(task.get_future());
+        work_queue.push(std::move(task));
+        return res;
+    }
+
+    // 不分配共享状态的submit, 返回的light_future必须在当前作用域内接收
+    template<typename FunctionType>
+    light_future<typename std::result_of<FunctionType()>::type>
+    submit_light(FunctionType f)
+    {
+        typedef typename std::result_of<FunctionType()>::type result_type;
+
+        return light_future<result_type>(
+            [this,&f](light_promise<result_type> promise) {
+                work_queue.push(
+                    [promise=std::move(promise),f=std::move(f)]() mutable {
+                        promise.run(f);
+                    });
+            });
+    }
+};